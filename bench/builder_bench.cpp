@@ -0,0 +1,305 @@
+/**
+ * @brief Builder construction benchmark
+ * @details
+ * Builds representative trees with nwidget and with hand-written Qt code under the offscreen platform, and reports
+ * the median over the iterations of:
+ *      - construct : time to build the widget tree
+ *      - paint     : time from show() until the first frame has been rendered
+ *      - allocs    : number of operator new calls while building
+ *      - peak RSS  : peak resident set size of the process after the scenario
+ *
+ * Usage:
+ *      nwidget_bench_builder [iterations] [scenario]
+ *
+ * Notes:
+ *      - Peak RSS only grows during the process, run a single scenario to compare the variants by RSS.
+ *      - Allocations made inside the Qt libraries are only counted where the global operator new can be replaced
+ *        for the whole process, which is not the case on Windows.
+ */
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFormLayout>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QScrollArea>
+#include <QTabWidget>
+#include <QVBoxLayout>
+
+#include <nwidget/builders.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (const auto p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static long peakRssKiB()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+#else
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef Q_OS_MACOS
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+using namespace nwidget;
+
+/* ------------------------------------------------------ Trees ----------------------------------------------------- */
+
+namespace form {
+
+QWidget* nwidget(int rows)
+{
+    return Widget(FormLayout{
+        ForEach(0,
+                rows,
+                [](int i) { return FormLayoutItem(QString("Row %1").arg(i), LineEdit().text(QString::number(i))); }),
+    });
+}
+
+QWidget* qt(int rows)
+{
+    auto w = new QWidget;
+    auto l = new QFormLayout(w);
+    for (int i = 0; i < rows; ++i) {
+        auto edit = new QLineEdit;
+        edit->setText(QString::number(i));
+        l->addRow(QString("Row %1").arg(i), edit);
+    }
+    return w;
+}
+
+} // namespace form
+
+namespace mix {
+
+// 10 rows of 4 grids of 5x5 buttons
+QWidget* nwidget()
+{
+    return Widget(VBoxLayout{
+        ForEach(0,
+                10,
+                [](int) {
+                    return BoxLayoutItem(HBoxLayout{
+                        ForEach(0,
+                                4,
+                                [](int) {
+                                    return BoxLayoutItem(GridLayout{
+                                        ForEach(0,
+                                                25,
+                                                [](int i) {
+                                                    return GridLayoutItem(i / 5,
+                                                                          i % 5,
+                                                                          PushButton(QString::number(i)));
+                                                }),
+                                    });
+                                }),
+                    });
+                }),
+    });
+}
+
+QWidget* qt()
+{
+    auto w    = new QWidget;
+    auto vbox = new QVBoxLayout(w);
+    for (int r = 0; r < 10; ++r) {
+        auto hbox = new QHBoxLayout;
+        for (int g = 0; g < 4; ++g) {
+            auto grid = new QGridLayout;
+            for (int i = 0; i < 25; ++i)
+                grid->addWidget(new QPushButton(QString::number(i)), i / 5, i % 5);
+            hbox->addLayout(grid);
+        }
+        vbox->addLayout(hbox);
+    }
+    return w;
+}
+
+} // namespace mix
+
+namespace tabs {
+
+// 100 pages with a form of 10 rows each
+QWidget* nwidget()
+{
+    return TabWidget{
+        ForEach(0,
+                100,
+                [](int p) {
+                    return TabWidgetItem(QString("Page %1").arg(p),
+                                         Widget(FormLayout{
+                                             ForEach(0,
+                                                     10,
+                                                     [](int i) {
+                                                         return FormLayoutItem(QString("Row %1").arg(i), LineEdit());
+                                                     }),
+                                         }));
+                }),
+    };
+}
+
+QWidget* qt()
+{
+    auto tab = new QTabWidget;
+    for (int p = 0; p < 100; ++p) {
+        auto page = new QWidget;
+        auto form = new QFormLayout(page);
+        for (int i = 0; i < 10; ++i)
+            form->addRow(QString("Row %1").arg(i), new QLineEdit);
+        tab->addTab(page, QString("Page %1").arg(p));
+    }
+    return tab;
+}
+
+} // namespace tabs
+
+namespace foreach_ {
+
+QWidget* nwidget(int n)
+{
+    return Widget(VBoxLayout{
+        ForEach(0, n, [](int i) { return BoxLayoutItem(Label(QString::number(i))); }),
+    });
+}
+
+QWidget* qt(int n)
+{
+    auto w = new QWidget;
+    auto l = new QVBoxLayout(w);
+    for (int i = 0; i < n; ++i)
+        l->addWidget(new QLabel(QString::number(i)));
+    return w;
+}
+
+} // namespace foreach_
+
+/* ----------------------------------------------------- Runner ----------------------------------------------------- */
+
+struct Scenario
+{
+    const char*              name;
+    std::function<QWidget*()> nwidget;
+    std::function<QWidget*()> qt;
+};
+
+struct Result
+{
+    double      construct;
+    double      paint;
+    std::size_t allocs;
+};
+
+static Result measure(const std::function<QWidget*()>& build)
+{
+    QElapsedTimer timer;
+
+    const auto allocs0 = allocations.load();
+    timer.start();
+    const auto root = build();
+    Result     r{timer.nsecsElapsed() / 1e6, 0, allocations.load() - allocs0};
+
+    auto area = new QScrollArea;
+    area->setWidget(root);
+    area->resize(1024, 768);
+
+    timer.restart();
+    area->show();
+    area->grab();
+    r.paint = timer.nsecsElapsed() / 1e6;
+
+    delete area;
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    return r;
+}
+
+template <typename T> static T median(std::vector<T> v)
+{
+    std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    return v[v.size() / 2];
+}
+
+static void run(const char* scenario, const char* variant, const std::function<QWidget*()>& build, int iterations)
+{
+    std::vector<double>      construct, paint;
+    std::vector<std::size_t> allocs;
+    for (int i = 0; i < iterations; ++i) {
+        const auto r = measure(build);
+        construct.push_back(r.construct);
+        paint.push_back(r.paint);
+        allocs.push_back(r.allocs);
+    }
+
+    std::printf("%-12s %-8s %12.3f %12.3f %12zu %12ld\n",
+                scenario,
+                variant,
+                median(construct),
+                median(paint),
+                median(allocs),
+                peakRssKiB());
+}
+
+int main(int argc, char* argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+
+    const auto args       = QApplication::arguments();
+    const int  iterations = args.size() > 1 ? std::max(1, args[1].toInt()) : 5;
+    const auto only       = args.size() > 2 ? args[2] : QString();
+
+    const std::vector<Scenario> scenarios = {
+        {"form-100", [] { return form::nwidget(100); }, [] { return form::qt(100); }},
+        {"form-1k", [] { return form::nwidget(1000); }, [] { return form::qt(1000); }},
+        {"grid-box", mix::nwidget, mix::qt},
+        {"tabs-100", tabs::nwidget, tabs::qt},
+        {"foreach-10k", [] { return foreach_::nwidget(10000); }, [] { return foreach_::qt(10000); }},
+    };
+
+    std::printf("%-12s %-8s %12s %12s %12s %12s\n", "scenario", "variant", "construct ms", "paint ms", "allocs", "peak KiB");
+    for (const auto& s : scenarios) {
+        if (!only.isEmpty() && only != QLatin1String(s.name))
+            continue;
+        run(s.name, "qt", s.qt, iterations);
+        run(s.name, "nwidget", s.nwidget, iterations);
+    }
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * @brief A translation unit using the common builders, to compare compile times with and without nwidget_prebuilt
+ */
+
+#include <nwidget/prebuilt.h>
+
+using namespace nwidget;
+
+QWidget* buildCompileBench()
+{
+    return Widget(VBoxLayout{
+        HBoxLayout{
+            Label("Name"),
+            LineEdit().placeholderText("Name"),
+            PushButton("Clear"),
+        },
+        FormLayout{
+            {"Check", CheckBox("Enabled").checked(true)},
+            {"Radio", RadioButton("Option")},
+            {"Tool", ToolButton().text("...")},
+            {"Link", CommandLinkButton("Next", "Go to the next page")},
+            {"Spin", SpinBox().range(0, 100).value(50)},
+            {"Double", DoubleSpinBox().range(0, 1).value(0.5)},
+            {"Date", DateEdit()},
+            {"Time", TimeEdit()},
+            {"DateTime", DateTimeEdit()},
+            {"Combo", ComboBox(QStringList{"A", "B", "C"})},
+            {"Slider", Slider(Qt::Horizontal).range(0, 100)},
+            {"Dial", Dial().range(0, 100)},
+            {"Scroll", ScrollBar(Qt::Horizontal)},
+            {"Progress", ProgressBar().range(0, 100).value(25)},
+        },
+        GridLayout{
+            {0, 0, ListWidget()},
+            {0, 1, TableWidget()},
+            {1, 0, TreeWidget()},
+            {1, 1, TextBrowser()},
+            {2, 0, PlainTextEdit()},
+            {2, 1, TextEdit()},
+        },
+        GroupBox("Group", VBoxLayout{TabBar(), MenuBar()}),
+        TabWidget{{"Page", Widget(StackedLayout{})}},
+        DialogButtonBox(),
+    });
+}
@@ -24,6 +24,11 @@
  *          Behavior::animated(
  *              MetaObject().property()));
  *      @endcode
+ *
+ * Animate a property set by a builder, the initial value is applied without animation:
+ *      @code{.cpp}
+ *      Label().minimumWidth(animated(slider.value() * 2, new SmoothedAnimation<int>));
+ *      @endcode
  */
 
 #ifndef NWIDGET_BEHAVIOR_H
@@ -237,6 +242,59 @@ private:
     }
 };
 
+/* ---------------------------------------------------- Animated ---------------------------------------------------- */
+
+namespace impl::behavior {
+
+template <typename T> struct is_expr : std::false_type {};
+template <typename... T> struct is_expr<MetaProperty<T...>> : std::true_type {};
+template <typename... T> struct is_expr<BindingExpr<T...>> : std::true_type {};
+
+template <typename... T> auto eval(MetaProperty<T...> prop) { return prop.get(); }
+template <typename... T> auto eval(const BindingExpr<T...>& expr) { return expr.eval(); }
+
+} // namespace impl::behavior
+
+/// A value, MetaProperty or BindingExpr to be applied to a property through a Behavior
+template <typename Expr, typename Anim> class Animated
+{
+public:
+    Animated(const Expr& expr, Anim* anim)
+        : expr(expr)
+        , anim(anim)
+    {
+    }
+
+    template <typename... Ts> void applyTo(MetaProperty<Ts...> prop) const
+    {
+        using MetaProp = MetaProperty<Ts...>;
+        using Type     = typename MetaProp::Type;
+
+        // the initial value is written directly, the animation only starts with the next change
+        const auto initial = [this]
+        {
+            if constexpr (impl::behavior::is_expr<Expr>::value)
+                return static_cast<Type>(impl::behavior::eval(expr));
+            else
+                return static_cast<Type>(expr);
+        }();
+        MetaProp::write(prop.object(), initial);
+
+        Behavior::on(prop, anim, initial);
+        if constexpr (impl::behavior::is_expr<Expr>::value)
+            Behavior::animated(prop) = expr;
+    }
+
+private:
+    Expr  expr;
+    Anim* anim;
+};
+
+template <typename Expr, typename Anim> Animated<std::decay_t<Expr>, Anim> animated(const Expr& expr, Anim* anim)
+{
+    return {expr, anim};
+}
+
 /* ------------------------------------------------ Builtin Animation ----------------------------------------------- */
 
 // clang-format off
@@ -32,6 +32,62 @@
  *        - [](const T& e)            -> BuilderItem { ... }
  *        - [](int index, const T& e) -> BuilderItem { ... }
  *
+ *      The generator may also return anything the item can be constructed from, e.g. a widget. The data is iterated
+ *      when the items are added, each generated value is added directly without being stored or type-erased.
+ *
+ * Use ForEach(property, key, generator) to create items that follow an observable container:
+ *      @code{.cpp}
+ *      // model.items() is a MetaProperty with a notify signal, e.g. of type QStringList
+ *      QLayout* layout = VBoxLayout{
+ *          ForEach(model.items(),
+ *                  [](const QString& e) { return e; },                   // key
+ *                  [](const QString& e) { return new QPushButton(e); }), // generator
+ *      };
+ *      @endcode
+ *
+ *      When the property changes, the items are diffed by key: widgets of removed keys are deleted,
+ *      new keys are generated and moved keys are reordered, the widgets of other keys are kept.
+ *
+ * Layouts also accept their items as constructor arguments, each item is added directly with its own type
+ * instead of being wrapped into a type-erased layout item first:
+ *      @code{.cpp}
+ *      QLayout* layout = VBoxLayout(
+ *          new QLabel("Name"),
+ *          GridLayout(
+ *              GridLayout::Cell(0, 0, new QLineEdit),
+ *              GridLayout::Cell(0, 1, Qt::AlignRight, new QPushButton("OK"))
+ *          ),
+ *          FormLayout(
+ *              FormLayout::Row("Age", new QSpinBox)
+ *          )
+ *      );
+ *      @endcode
+ *
+ * Properties also accept a MetaProperty, a BindingExpr or an animated value, the binding is set up on the new object:
+ *      @code{.cpp}
+ *      auto slider = MetaObject<>::from(new QSlider);
+ *
+ *      BindingBatch batch; // optional, bindings of the subtree are registered when the batch ends
+ *      QLayout* layout = VBoxLayout{
+ *          Label().text(cast<QString>(slider.value())),
+ *          ProgressBar().value(slider.value()),
+ *          Widget().minimumWidth(animated(slider.value() * 2, new SmoothedAnimation<int>)),
+ *      };
+ *      @endcode
+ *
+ * Items can be added in time slices on the event loop with IncrementalBuild of incremental.h:
+ *      @code{.cpp}
+ *      IncrementalBuild build;
+ *      QWidget* list = Widget(VBoxLayout{
+ *          ForEach(0, 10000, [](int i) { return new QLabel(QString::number(i)); }),
+ *      });
+ *      @endcode
+ *
+ * Properties accept pending resources of resource.h, the placeholder is replaced once the resource is loaded:
+ *      @code{.cpp}
+ *      PushButton("Open").icon(Resources::icon(":/icons/open.png"));
+ *      @endcode
+ *
  * To register builder for a class, as for:
  *      @code{.cpp}
  *      class MyClass : public QObject
@@ -82,11 +138,72 @@
 #ifndef NWIDGET_BUILDER_H
 #define NWIDGET_BUILDER_H
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace nwidget {
 
+/* -------------------------------------------------- BindingBatch -------------------------------------------------- */
+
+namespace impl::builder {
+
+template <typename Func> void bind(Func func);
+
+} // namespace impl::builder
+
+/// Defer the bindings created by builders until the end of the scope, nested batches join the outermost one
+class BindingBatch
+{
+    template <typename Func> friend void impl::builder::bind(Func);
+
+public:
+    BindingBatch()
+        : outer(current())
+    {
+        current() = this;
+    }
+
+    ~BindingBatch()
+    {
+        current() = outer;
+        if (outer)
+            std::move(pending.begin(), pending.end(), std::back_inserter(outer->pending));
+        else
+            for (const auto& bind : pending)
+                bind();
+    }
+
+    BindingBatch(const BindingBatch&)            = delete;
+    BindingBatch& operator=(const BindingBatch&) = delete;
+
+private:
+    BindingBatch*                      outer;
+    std::vector<std::function<void()>> pending;
+
+    static BindingBatch*& current()
+    {
+        static thread_local BindingBatch* batch = nullptr;
+        return batch;
+    }
+};
+
+namespace impl::builder {
+
+template <typename Func> void bind(Func func)
+{
+    if (const auto batch = BindingBatch::current())
+        batch->pending.emplace_back(std::move(func));
+    else
+        func();
+}
+
+} // namespace impl::builder
+
 /* ----------------------------------------------------- Builder ---------------------------------------------------- */
 
 #define N_BUILDER(CLASS)                                                                                               \
@@ -111,6 +228,36 @@ public:
         static_assert(MetaProp::isWritable);                                                                           \
         MetaProp::write(self().o, value);                                                                              \
         return self();                                                                                                 \
+    }                                                                                                                  \
+    template <typename... Ts> Self& NAME(const ::nwidget::BindingExpr<Ts...>& expr)                                    \
+    {                                                                                                                  \
+        using MetaProp = decltype(std::declval<::nwidget::MetaObject<Class>>().NAME());                                \
+        static_assert(MetaProp::isWritable);                                                                           \
+        ::nwidget::impl::builder::bind([prop = MetaProp(self().o), expr] { prop = expr; });                            \
+        return self();                                                                                                 \
+    }                                                                                                                  \
+    template <typename... Ts> Self& NAME(::nwidget::MetaProperty<Ts...> source)                                        \
+    {                                                                                                                  \
+        using MetaProp = decltype(std::declval<::nwidget::MetaObject<Class>>().NAME());                                \
+        static_assert(MetaProp::isWritable);                                                                           \
+        ::nwidget::impl::builder::bind([prop = MetaProp(self().o), source] { prop = source; });                        \
+        return self();                                                                                                 \
+    }                                                                                                                  \
+    template <typename Expr, typename Anim> Self& NAME(const ::nwidget::Animated<Expr, Anim>& value)                   \
+    {                                                                                                                  \
+        using MetaProp = decltype(std::declval<::nwidget::MetaObject<Class>>().NAME());                                \
+        static_assert(MetaProp::isWritable);                                                                           \
+        ::nwidget::impl::builder::bind([prop = MetaProp(self().o), value] { value.applyTo(prop); });                   \
+        return self();                                                                                                 \
+    }                                                                                                                  \
+    template <typename T> Self& NAME(const ::nwidget::Pending<T>& pending)                                             \
+    {                                                                                                                  \
+        using MetaProp = decltype(std::declval<::nwidget::MetaObject<Class>>().NAME());                                \
+        static_assert(MetaProp::isWritable);                                                                           \
+        MetaProp::write(self().o, pending.value());                                                                    \
+        if (!pending.isReady())                                                                                        \
+            pending.then(self().o, [o = self().o](const T& value) { MetaProp::write(o, value); });                     \
+        return self();                                                                                                 \
     }
 
 #define N_IMPL_ARGS_IMPL0_0()
@@ -161,10 +308,59 @@ public:
 
 template <typename...> class Builder;
 
+namespace impl::builder {
+
+/// Takes the work of adding items while an IncrementalBuild is active, see incremental.h
+class Scheduler
+{
+public:
+    /// Run step until it returns false, each call adds one item. Steps posted by a running step run before it resumes
+    virtual void post(std::function<bool()> step) = 0;
+
+    static Scheduler*& current()
+    {
+        static thread_local Scheduler* scheduler = nullptr;
+        return scheduler;
+    }
+
+protected:
+    ~Scheduler() = default;
+};
+
+/// Call the adders in order, or one per step while an IncrementalBuild is active
+template <typename... Adders> void addInOrder(Adders... adders)
+{
+    if (const auto scheduler = Scheduler::current()) {
+        std::vector<std::function<void()>> steps{std::function<void()>(std::move(adders))...};
+        scheduler->post(
+            [steps = std::move(steps), i = std::size_t(0)]() mutable
+            {
+                if (i == steps.size())
+                    return false;
+                steps[i++]();
+                return i < steps.size();
+            });
+    } else
+        (adders(), ...);
+}
+
+/// Notified of every object created by a builder, specialized by builders.h to record factories of QObject classes
+template <typename Class, typename = void> struct Created
+{
+    static void notify(Class*) {}
+};
+
+} // namespace impl::builder
+
 template <typename Self> class Builder<void, Self>
 {
 public:
-    Builder() { static_cast<Self*>(this)->o = new typename Self::Class; }
+    Builder()
+    {
+        const auto o               = new typename Self::Class;
+        static_cast<Self*>(this)->o = o;
+        impl::builder::Created<typename Self::Class>::notify(o);
+    }
 
     explicit Builder(void* o) { static_cast<Self*>(this)->o = static_cast<typename Self::Class*>(o); }
 };
@@ -185,6 +381,20 @@ private:
 
     template <typename Items> Builder& addItems(const Items& items)
     {
+        if (const auto scheduler = impl::builder::Scheduler::current()) {
+            using Item = std::decay_t<decltype(*std::begin(items))>;
+            scheduler->post(
+                [items = std::vector<Item>(std::begin(items), std::end(items)), i = std::size_t(0), o = o]() mutable
+                {
+                    if (i == items.size())
+                        return false;
+                    const auto& item = items[i++];
+                    item.func(&item, o);
+                    return i < items.size();
+                });
+            return *this;
+        }
+
         for (const auto& item : items)
             item.func(&item, o);
         return *this;
@@ -195,6 +405,8 @@ private:
 
 template <typename Item> using BuilderItemGenerator = std::function<std::optional<Item>()>;
 
+template <typename Iterator, typename Generator> class ForEachRange;
+
 template <typename T> class BuilderItem
 {
     template <typename...> friend class Builder;
@@ -206,6 +418,18 @@ public:
     {
         func = [gen](const BuilderItem*, T* target)
         {
+            if (const auto scheduler = impl::builder::Scheduler::current()) {
+                scheduler->post(
+                    [gen, target]() mutable
+                    {
+                        auto item = gen();
+                        if (item)
+                            item->func(&*item, target);
+                        return item.has_value();
+                    });
+                return;
+            }
+
             while (auto item = gen())
                 item->func(&*item, target);
         };
@@ -216,93 +440,239 @@ public:
 protected:
     explicit BuilderItem(Func f) { func = f; }
 
+    /// Add item to target, for items holding nested items of their own kind
+    static void addTo(const BuilderItem& item, T* target) { item.func(&item, target); }
+
+    /// Func adding the items of range, values which are not builder items are converted to Item one at a time
+    template <typename Item, typename Iterator, typename Generator>
+    static Func expand(const ForEachRange<Iterator, Generator>& range)
+    {
+        return [range](const BuilderItem*, T* target)
+        {
+            const auto add = [target](auto&& value)
+            {
+                using Value = std::decay_t<decltype(value)>;
+                if constexpr (std::is_base_of_v<BuilderItem, Value>) {
+                    const BuilderItem& item = value;
+                    item.func(&item, target);
+                } else {
+                    const Item item(std::forward<decltype(value)>(value));
+                    static_cast<const BuilderItem&>(item).func(&item, target);
+                }
+            };
+
+            if (const auto scheduler = impl::builder::Scheduler::current())
+                scheduler->post(range.steps(add));
+            else
+                range.forEach(add);
+        };
+    }
+
 private:
     Func func;
 };
 
 /* ----------------------------------------------------- ForEach ---------------------------------------------------- */
 
-template <typename Iterator, typename Generator>
-auto ForEach(Iterator begin, Iterator end, Generator gen)
-    -> std::enable_if_t<std::is_invocable_v<Generator>, BuilderItemGenerator<std::invoke_result_t<Generator>>>
+namespace impl::builder {
+
+template <typename T> struct CountingIterator
 {
-    return [begin, end, gen]() mutable -> std::optional<decltype(gen(*begin))>
+    T value;
+
+    T operator*() const { return value; }
+
+    bool operator==(const CountingIterator& other) const { return value == other.value; }
+    bool operator!=(const CountingIterator& other) const { return value != other.value; }
+
+    CountingIterator& operator++()
     {
-        if (begin == end)
-            return std::nullopt;
-        auto item = gen(*begin);
-        ++begin;
-        return item;
-    };
-}
+        ++value;
+        return *this;
+    }
+};
 
-template <typename Iterator, typename Generator>
-auto ForEach(Iterator begin, Iterator end, Generator gen)
-    -> std::enable_if_t<std::is_invocable_v<Generator, decltype(*begin)>,
-                        BuilderItemGenerator<std::invoke_result_t<Generator, decltype(*begin)>>>
+} // namespace impl::builder
+
+/// Items generated from a range, the range is iterated in place when the items are added, owner keeps a container
+/// owned by the range alive
+template <typename Iterator, typename Generator> class ForEachRange
 {
-    return [begin, end, gen]() mutable -> std::optional<decltype(gen(*begin))>
+public:
+    ForEachRange(Iterator begin, Iterator end, Generator gen, std::shared_ptr<const void> owner = {})
+        : begin(begin)
+        , end(end)
+        , gen(gen)
+        , owner(std::move(owner))
     {
-        if (begin == end)
-            return std::nullopt;
-        auto item = gen(*begin);
-        ++begin;
-        return item;
-    };
-}
+    }
+
+    template <typename Func> void forEach(Func func) const
+    {
+        int index = 0;
+        for (auto it = begin; it != end; ++it, ++index)
+            func(generate(index, it));
+    }
+
+    /// A step calling func with the next generated value, returns false once the range is exhausted
+    template <typename Func> std::function<bool()> steps(Func func) const
+    {
+        return [index = (int)0, it = begin, range = *this, func]() mutable
+        {
+            if (it == range.end)
+                return false;
+            func(range.generate(index, it));
+            ++index;
+            ++it;
+            return it != range.end;
+        };
+    }
+
+    template <typename Item> operator BuilderItemGenerator<Item>() const
+    {
+        return [index = (int)0, it = begin, range = *this]() mutable -> std::optional<Item>
+        {
+            if (it == range.end)
+                return std::nullopt;
+            std::optional<Item> item(range.generate(index, it));
+            ++index;
+            ++it;
+            return item;
+        };
+    }
+
+private:
+    Iterator                    begin;
+    Iterator                    end;
+    mutable Generator           gen;
+    std::shared_ptr<const void> owner;
+
+    decltype(auto) generate(int index, const Iterator& it) const
+    {
+        if constexpr (std::is_invocable_v<Generator&, int, decltype(*it)>)
+            return gen(index, *it);
+        else if constexpr (std::is_invocable_v<Generator&, decltype(*it)>)
+            return gen(*it);
+        else
+            return gen();
+    }
+};
 
 template <typename Iterator, typename Generator>
 auto ForEach(Iterator begin, Iterator end, Generator gen)
-    -> std::enable_if_t<std::is_invocable_v<Generator, int, decltype(*begin)>,
-                        BuilderItemGenerator<std::invoke_result_t<Generator, int, decltype(*begin)>>>
+    -> std::enable_if_t<!std::is_integral_v<Iterator>, ForEachRange<Iterator, Generator>>
 {
-    return [index = (int)0, begin, end, gen]() mutable -> std::optional<decltype(gen(0, *begin))>
-    {
-        if (begin == end)
-            return std::nullopt;
-        auto item = gen(index, *begin);
-        ++index;
-        ++begin;
-        return item;
-    };
+    return {begin, end, gen};
 }
 
 template <typename T, typename Generator>
 auto ForEach(T begin, T end, Generator gen)
-    -> std::enable_if_t<std::is_integral_v<T>, BuilderItemGenerator<std::invoke_result_t<Generator, T>>>
+    -> std::enable_if_t<std::is_integral_v<T>, ForEachRange<impl::builder::CountingIterator<T>, Generator>>
 {
-    struct iterator
-    {
-        T value;
+    return {{begin}, {end}, gen};
+}
 
-        T operator*() const { return value; }
+/// An lvalue container is referenced and must outlive the items, an rvalue container is moved into the range
+template <typename T, typename Generator> auto ForEach(T&& c, Generator g)
+{
+    using Container = std::decay_t<T>;
+    if constexpr (std::is_integral_v<Container>) {
+        return ForEach(Container(0), c, g);
+    } else if constexpr (std::is_lvalue_reference_v<T>) {
+        const Container& container = c;
+        return ForEach(container.begin(), container.end(), g);
+    } else {
+        const auto container = std::make_shared<const Container>(std::move(c));
+        using Iterator       = decltype(container->begin());
+        return ForEachRange<Iterator, Generator>(container->begin(), container->end(), g, container);
+    }
+}
 
-        bool operator==(const iterator& other) const { return value == other.value; }
-        bool operator!=(const iterator& other) const { return value != other.value; }
+/// The values of the list are copied, the array of an initializer list does not outlive the full expression
+template <typename T, typename Generator> auto ForEach(std::initializer_list<T> l, Generator g)
+{
+    return ForEach(std::vector<T>(l), g);
+}
 
-        iterator& operator++()
-        {
-            ++value;
-            return *this;
-        }
-    };
+/* -------------------------------------------------- KeyedForEach -------------------------------------------------- */
 
-    return ForEach(iterator{begin}, iterator{end}, gen);
-}
+template <typename Source, typename Key, typename Generator> struct KeyedForEach
+{
+    Source    source;
+    Key       key;
+    Generator gen;
+};
 
-template <typename T, typename Generator> auto ForEach(const T& c, Generator g)
+template <typename Source, typename Key, typename Generator>
+auto ForEach(Source source, Key key, Generator gen)
+    -> std::enable_if_t<Source::hasNotifySignal, KeyedForEach<Source, Key, Generator>>
 {
-    if constexpr (std::is_integral_v<T>)
-        return ForEach(0, c, g);
-    else
-        return ForEach(c.begin(), c.end(), g);
+    return {source, key, gen};
 }
 
-template <typename T, typename Generator> auto ForEach(std::initializer_list<T> l, Generator g)
+namespace impl::builder {
+
+struct KeyedDiff
 {
-    return ForEach(l.begin(), l.end(), g);
+    std::vector<int>  source;  // new index -> reused old index, -1 if the item is inserted
+    std::vector<bool> moved;   // new index -> the reused item has to be moved
+    std::vector<int>  removed; // old indices which are not reused
+};
+
+template <typename Key> KeyedDiff keyedDiff(const std::vector<Key>& from, const std::vector<Key>& to)
+{
+    const int m = static_cast<int>(from.size());
+    const int n = static_cast<int>(to.size());
+
+    KeyedDiff diff;
+    diff.source.assign(n, -1);
+    diff.moved.assign(n, false);
+
+    std::unordered_map<Key, int> index;
+    index.reserve(m);
+    for (int i = 0; i < m; ++i)
+        index.emplace(from[i], i);
+
+    std::vector<bool> reused(m, false);
+    for (int i = 0; i < n; ++i) {
+        const auto it = index.find(to[i]);
+        if (it == index.end() || reused[it->second])
+            continue;
+        diff.source[i]      = it->second;
+        reused[it->second] = true;
+    }
+
+    for (int i = 0; i < m; ++i)
+        if (!reused[i])
+            diff.removed.push_back(i);
+
+    // The longest increasing run of reused old indices keeps its place, everything else is moved
+    std::vector<int> tails; // tails[k]: new index ending the best run of length k + 1
+    std::vector<int> prev(n, -1);
+    for (int i = 0; i < n; ++i) {
+        if (diff.source[i] < 0)
+            continue;
+        const auto pos = std::lower_bound(tails.begin(),
+                                          tails.end(),
+                                          diff.source[i],
+                                          [&](int t, int s) { return diff.source[t] < s; })
+                       - tails.begin();
+        if (pos > 0)
+            prev[i] = tails[pos - 1];
+        if (pos == static_cast<int>(tails.size()))
+            tails.push_back(i);
+        else
+            tails[pos] = i;
+        diff.moved[i] = true;
+    }
+    for (int i = tails.empty() ? -1 : tails.back(); i >= 0; i = prev[i])
+        diff.moved[i] = false;
+
+    return diff;
 }
 
+} // namespace impl::builder
+
 } // namespace nwidget
 
 #endif // NWIDGET_BUILDER_H
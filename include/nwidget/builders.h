@@ -4,6 +4,35 @@
 #include "builder.h"
 #include "metaobjects.h"
 
+#ifdef QWIDGET_H
+#include "stylesheet.h"
+#endif
+
+#if defined(QWIDGET_H) || defined(QACTION_H)
+#include "icons.h"
+#endif
+
+#if defined(QABSTRACTITEMVIEW_H) || defined(QCOMBOBOX_H)
+#include "models.h"
+#endif
+
+#if defined(QPLAINTEXTEDIT_H) || defined(QTEXTEDIT_H)
+#include "loaders.h"
+#endif
+
+#ifdef QLABEL_H
+#include "resource.h"
+#endif
+
+#ifdef QTABLEVIEW_H
+#include "filemodels.h"
+#include "proxies.h"
+#endif
+
+#if defined(QLINEEDIT_H) && QT_CONFIG(completer)
+#include "completer.h"
+#endif
+
 class QWidget;
 class QLayout;
 class QLayoutItem;
@@ -11,6 +40,36 @@ class QLayoutItem;
 namespace nwidget {
 
 #ifdef QOBJECT_H
+namespace impl::builders {
+
+using Factory = QObject* (*)();
+
+/// Default constructors of the classes created by builders, keyed by their meta-object
+inline std::unordered_map<const QMetaObject*, Factory>& factories()
+{
+    static std::unordered_map<const QMetaObject*, Factory> f;
+    return f;
+}
+
+} // namespace impl::builders
+
+namespace impl::builder {
+
+template <typename Class> struct Created<Class, std::enable_if_t<std::is_base_of_v<QObject, Class>>>
+{
+    static void notify(Class* o)
+    {
+        // A class without Q_OBJECT shares the meta-object of its base, do not record it in place of the base
+        static const bool recorded = o->metaObject() == &Class::staticMetaObject
+                                  && impl::builders::factories().emplace(&Class::staticMetaObject, [] {
+                                         return static_cast<QObject*>(new Class);
+                                     }).second;
+        Q_UNUSED(recorded)
+    }
+};
+
+} // namespace impl::builder
+
 template <typename Self> class Builder<QObject, Self> : public Builder<void, Self>
 {
     N_BUILDER(QObject)
@@ -39,6 +98,7 @@ template <typename Self> class Builder<QAction, Self> : public Builder<QObject,
     N_BUILDER_PROPERTY(checked)
     N_BUILDER_PROPERTY(enabled)
     N_BUILDER_PROPERTY(icon)
+    Self& icon(const QString& path) { return self().icon(IconCache::icon(path)); }
     N_BUILDER_PROPERTY(text)
     N_BUILDER_PROPERTY(iconText)
     N_BUILDER_PROPERTY(toolTip)
@@ -69,6 +129,15 @@ using Action = Builder<QAction>;
 #endif
 
 #ifdef QLAYOUT_H
+namespace impl::builders {
+
+// Arguments of a variadic layout constructor, a single Class* argument wraps an existing layout instead
+template <typename Class, typename... Items>
+constexpr bool is_item_pack_v = sizeof...(Items) > 1
+                             || (sizeof...(Items) == 1 && (... && !std::is_convertible_v<Items, Class*>));
+
+} // namespace impl::builders
+
 template <typename T> class LayoutItem : public BuilderItem<T>
 {
 public:
@@ -137,11 +206,103 @@ using Layout = Builder<QLayout>;
 #endif
 
 #ifdef QBOXLAYOUT_H
+namespace impl::builders {
+
+template <typename MetaProp, typename KeyFunc, typename Generator> class KeyedBoxLayoutPatcher : public QObject
+{
+    using Container = typename MetaProp::Type;
+    using Element   = std::decay_t<decltype(*std::begin(std::declval<const Container&>()))>;
+    using Key       = std::decay_t<std::invoke_result_t<KeyFunc, const Element&>>;
+
+public:
+    KeyedBoxLayoutPatcher(QBoxLayout* layout, typename MetaProp::Class* source, KeyFunc key, Generator gen)
+        : QObject(layout)
+        , layout(layout)
+        , source(source)
+        , anchor(new QSpacerItem(0, 0))
+        , key(key)
+        , gen(gen)
+    {
+        static_assert(MetaProp::isReadable);
+
+        setObjectName("nwidget::KeyedForEach");
+        layout->addItem(anchor);
+        patch();
+        QObject::connect(source, MetaProp::notify(), this, [this] { patch(); });
+    }
+
+private:
+    QBoxLayout*               layout;
+    typename MetaProp::Class* source;
+    QSpacerItem*              anchor; // owned by the layout, items are inserted before it
+
+    KeyFunc   key;
+    Generator gen;
+
+    std::vector<Key>      keys;
+    std::vector<QWidget*> widgets;
+
+    void patch()
+    {
+        const Container data = MetaProp::read(source);
+
+        std::vector<const Element*> elements;
+        std::vector<Key>            newKeys;
+        for (const auto& e : data) {
+            elements.push_back(&e);
+            newKeys.push_back(key(e));
+        }
+
+        const auto diff = impl::builder::keyedDiff(keys, newKeys);
+        const int  n    = static_cast<int>(newKeys.size());
+
+        for (int i : diff.removed) {
+            layout->removeWidget(widgets[i]);
+            delete widgets[i];
+        }
+
+        // Walk backwards so that every item can be placed right before its already placed successor
+        std::vector<QWidget*> newWidgets(n);
+        for (int i = n - 1; i >= 0; --i) {
+            const int s = diff.source[i];
+            QWidget*  w = s < 0 ? static_cast<QWidget*>(gen(*elements[i])) : widgets[s];
+            if (s < 0 || diff.moved[i]) {
+                if (s >= 0)
+                    layout->removeWidget(w);
+                layout->insertWidget(i + 1 < n ? layout->indexOf(newWidgets[i + 1]) : layout->indexOf(anchor), w);
+            }
+            newWidgets[i] = w;
+        }
+
+        keys    = std::move(newKeys);
+        widgets = std::move(newWidgets);
+    }
+};
+
+} // namespace impl::builders
+
 class BoxLayoutItem : public LayoutItem<QBoxLayout>
 {
 public:
     using LayoutItem::LayoutItem;
 
+    template <typename Iterator, typename Generator>
+    BoxLayoutItem(ForEachRange<Iterator, Generator> range)
+        : LayoutItem(expand<BoxLayoutItem>(range))
+    {
+    }
+
+    template <typename... Ts, typename Key, typename Generator>
+    BoxLayoutItem(KeyedForEach<MetaProperty<Ts...>, Key, Generator> each)
+        : LayoutItem(
+              [each](const BuilderItem* item, QBoxLayout* l)
+              {
+                  using Patcher = impl::builders::KeyedBoxLayoutPatcher<MetaProperty<Ts...>, Key, Generator>;
+                  new Patcher(l, each.source.object(), each.key, each.gen);
+              })
+    {
+    }
+
     // clang-format off
     BoxLayoutItem(int stretch,                      QWidget* widget) : BoxLayoutItem(stretch, {}, widget) {}
     BoxLayoutItem(int stretch, Qt::Alignment align, QWidget* widget)
@@ -210,6 +371,21 @@ template <typename Self> class Builder<QBoxLayout, Self> : public Builder<QLayou
     static auto Stretch(int v = 0) { return BoxLayoutItem(BoxLayoutItem::stretch::tag, v); }
     static auto Strut  (int v    ) { return BoxLayoutItem(BoxLayoutItem::strut  ::tag, v); }
     // clang-format on
+
+protected:
+    template <typename Item> static void add(QBoxLayout* l, Item&& item)
+    {
+        if constexpr (std::is_convertible_v<Item, QWidget*>)
+            l->addWidget(item);
+        else if constexpr (std::is_convertible_v<Item, QLayout*>)
+            l->addLayout(item);
+        else if constexpr (std::is_convertible_v<Item, QLayoutItem*>)
+            l->addItem(item);
+        else {
+            const BoxLayoutItem i(std::forward<Item>(item));
+            i.func(&i, l);
+        }
+    }
 };
 
 template <typename Self> class Builder<QHBoxLayout, Self> : public Builder<QBoxLayout, Self>
@@ -217,6 +393,12 @@ template <typename Self> class Builder<QHBoxLayout, Self> : public Builder<QBoxL
     N_BUILDER(QHBoxLayout)
 
     Builder(std::initializer_list<BoxLayoutItem> items) { self().addItems(items); }
+
+    template <typename... Items, typename = std::enable_if_t<impl::builders::is_item_pack_v<Class, Items...>>>
+    explicit Builder(Items&&... items)
+    {
+        impl::builder::addInOrder([o = object(), item = std::forward<Items>(items)] { Builder::add(o, item); }...);
+    }
 };
 
 template <typename Self> class Builder<QVBoxLayout, Self> : public Builder<QBoxLayout, Self>
@@ -224,6 +406,12 @@ template <typename Self> class Builder<QVBoxLayout, Self> : public Builder<QBoxL
     N_BUILDER(QVBoxLayout)
 
     Builder(std::initializer_list<BoxLayoutItem> items) { self().addItems(items); }
+
+    template <typename... Items, typename = std::enable_if_t<impl::builders::is_item_pack_v<Class, Items...>>>
+    explicit Builder(Items&&... items)
+    {
+        impl::builder::addInOrder([o = object(), item = std::forward<Items>(items)] { Builder::add(o, item); }...);
+    }
 };
 
 using BoxLayout  = Builder<QBoxLayout>;
@@ -237,6 +425,12 @@ class FormLayoutItem : public LayoutItem<QFormLayout>
 public:
     using LayoutItem::LayoutItem;
 
+    template <typename Iterator, typename Generator>
+    FormLayoutItem(ForEachRange<Iterator, Generator> range)
+        : LayoutItem(expand<FormLayoutItem>(range))
+    {
+    }
+
     // clang-format off
     FormLayoutItem(const QString& label, QWidget* field) : LayoutItem([](const BuilderItem* item, Layout* layout){ auto s = static_cast<const FormLayoutItem*>(item); layout->addRow(s->text , static_cast<QWidget*>(s->field)); }), text( label), field(field) {}
     FormLayoutItem(const QString& label, QLayout* field) : LayoutItem([](const BuilderItem* item, Layout* layout){ auto s = static_cast<const FormLayoutItem*>(item); layout->addRow(s->text , static_cast<QLayout*>(s->field)); }), text( label), field(field) {}
@@ -250,18 +444,56 @@ private:
     void*    field = nullptr;
 };
 
+namespace impl::builders {
+
+template <typename Label, typename Field> struct FormLayoutRow
+{
+    Label label;
+    Field field;
+};
+
+template <typename T> struct is_form_layout_row : std::false_type {};
+template <typename L, typename F> struct is_form_layout_row<FormLayoutRow<L, F>> : std::true_type {};
+
+} // namespace impl::builders
+
 template <typename Self> class Builder<QFormLayout, Self> : public Builder<QLayout, Self>
 {
     N_BUILDER(QFormLayout)
 
     Builder(std::initializer_list<FormLayoutItem> items) { self().addItems(items); }
 
+    template <typename... Items, typename = std::enable_if_t<impl::builders::is_item_pack_v<Class, Items...>>>
+    explicit Builder(Items&&... items)
+    {
+        impl::builder::addInOrder([o = object(), item = std::forward<Items>(items)] { add(o, item); }...);
+    }
+
+    template <typename Label, typename Field> static auto Row(Label&& label, Field&& field)
+    {
+        return impl::builders::FormLayoutRow<std::decay_t<Label>, std::decay_t<Field>>{std::forward<Label>(label),
+                                                                                      std::forward<Field>(field)};
+    }
+
     N_BUILDER_PROPERTY(fieldGrowthPolicy)
     N_BUILDER_PROPERTY(rowWrapPolicy)
     N_BUILDER_PROPERTY(labelAlignment)
     N_BUILDER_PROPERTY(formAlignment)
     N_BUILDER_PROPERTY(horizontalSpacing)
     N_BUILDER_PROPERTY(verticalSpacing)
+
+private:
+    template <typename Item> static void add(QFormLayout* l, Item&& item)
+    {
+        if constexpr (impl::builders::is_form_layout_row<std::decay_t<Item>>::value)
+            l->addRow(item.label, item.field);
+        else if constexpr (std::is_convertible_v<Item, QWidget*> || std::is_convertible_v<Item, QLayout*>)
+            l->addRow(item);
+        else {
+            const FormLayoutItem i(std::forward<Item>(item));
+            i.func(&i, l);
+        }
+    }
 };
 
 using FormLayout = Builder<QFormLayout>;
@@ -273,6 +505,12 @@ class GridLayoutItem : public LayoutItem<QGridLayout>
 public:
     using LayoutItem::LayoutItem;
 
+    template <typename Iterator, typename Generator>
+    GridLayoutItem(ForEachRange<Iterator, Generator> range)
+        : LayoutItem(expand<GridLayoutItem>(range))
+    {
+    }
+
     // clang-format off
     GridLayoutItem(int row, int col,                                                QWidget* widget  ) : GridLayoutItem(row, col, 1      , 1      , {}   , widget) {}
     GridLayoutItem(int row, int col,                                                QLayoutItem* item) : GridLayoutItem(row, col, 1      , 1      , {}   , item  ) {}
@@ -299,6 +537,23 @@ private:
     Qt::Alignment align;
 };
 
+namespace impl::builders {
+
+template <typename Item> struct GridLayoutCell
+{
+    int           row;
+    int           col;
+    int           rowSpan;
+    int           colSpan;
+    Qt::Alignment align;
+    Item          item;
+};
+
+template <typename T> struct is_grid_layout_cell : std::false_type {};
+template <typename I> struct is_grid_layout_cell<GridLayoutCell<I>> : std::true_type {};
+
+} // namespace impl::builders
+
 template <typename Self> class Builder<QGridLayout, Self> : public Builder<QLayout, Self>
 {
     N_BUILDER(QGridLayout)
@@ -306,6 +561,22 @@ template <typename Self> class Builder<QGridLayout, Self> : public Builder<QLayo
 public:
     Builder(std::initializer_list<GridLayoutItem> items) { self().addItems(items); }
 
+    template <typename... Items, typename = std::enable_if_t<impl::builders::is_item_pack_v<Class, Items...>>>
+    explicit Builder(Items&&... items)
+    {
+        impl::builder::addInOrder([o = object(), item = std::forward<Items>(items)] { add(o, item); }...);
+    }
+
+    // clang-format off
+    template <typename Item> static auto Cell(int row, int col,                                                Item&& item) { return Cell(row, col, 1      , 1      , {}   , std::forward<Item>(item)); }
+    template <typename Item> static auto Cell(int row, int col, int rowSpan, int colSpan,                      Item&& item) { return Cell(row, col, rowSpan, colSpan, {}   , std::forward<Item>(item)); }
+    template <typename Item> static auto Cell(int row, int col,                           Qt::Alignment align, Item&& item) { return Cell(row, col, 1      , 1      , align, std::forward<Item>(item)); }
+    template <typename Item> static auto Cell(int row, int col, int rowSpan, int colSpan, Qt::Alignment align, Item&& item)
+    {
+        return impl::builders::GridLayoutCell<std::decay_t<Item>>{row, col, rowSpan, colSpan, align, std::forward<Item>(item)};
+    }
+    // clang-format on
+
     N_BUILDER_PROPERTY(horizontalSpacing)
     N_BUILDER_PROPERTY(verticalSpacing)
 
@@ -315,20 +586,218 @@ public:
     N_BUILDER_SETTER2(columnMinimumWidth, setColumnMinimumWidth)
     N_BUILDER_SETTER1(originCorner, setOriginCorner)
     N_BUILDER_SETTER2(defaultPositioning, setDefaultPositioning)
+
+private:
+    template <typename Item> static void add(QGridLayout* l, Item&& item)
+    {
+        if constexpr (impl::builders::is_grid_layout_cell<std::decay_t<Item>>::value) {
+            using Cell = decltype(item.item);
+            if constexpr (std::is_convertible_v<Cell, QWidget*>)
+                l->addWidget(item.item, item.row, item.col, item.rowSpan, item.colSpan, item.align);
+            else if constexpr (std::is_convertible_v<Cell, QLayout*>)
+                l->addLayout(item.item, item.row, item.col, item.rowSpan, item.colSpan, item.align);
+            else
+                l->addItem(item.item, item.row, item.col, item.rowSpan, item.colSpan, item.align);
+        } else {
+            const GridLayoutItem i(std::forward<Item>(item));
+            i.func(&i, l);
+        }
+    }
 };
 
 using GridLayout = Builder<QGridLayout>;
 #endif
 
 #ifdef QSTACKEDLAYOUT_H
+namespace impl::builders {
+
+/// Lazy pages of a stacked layout, built when shown and evicted in least recently used order when hidden
+class LazyPages : public QObject
+{
+public:
+    using Build = std::function<QWidget*()>;
+    using Size  = std::function<qint64(QWidget*)>;
+
+    static LazyPages* of(QStackedLayout* layout)
+    {
+        auto pages =
+            static_cast<LazyPages*>(layout->findChild<QObject*>("nwidget::LazyPages", Qt::FindDirectChildrenOnly));
+        if (!pages)
+            pages = new LazyPages(layout);
+        return pages;
+    }
+
+    void add(Build build, Size size)
+    {
+        const auto placeholder = new QWidget;
+        (new QStackedLayout(placeholder))->setContentsMargins(0, 0, 0, 0);
+        connect(placeholder, &QObject::destroyed, this, [this, placeholder] { remove(placeholder); });
+        pages.push_back({placeholder, std::move(build), std::move(size)});
+        layout->addWidget(placeholder);
+    }
+
+    void setLimits(int maxPages, qint64 maxBytes)
+    {
+        this->maxPages = maxPages;
+        this->maxBytes = maxBytes;
+        evict();
+    }
+
+private:
+    struct Page
+    {
+        QWidget* placeholder;
+        Build    build;
+        Size     size;
+        QWidget* content  = nullptr;
+        qint64   bytes    = 0;
+        quint64  lastUsed = 0;
+    };
+
+    QStackedLayout*   layout;
+    std::vector<Page> pages;
+    quint64           clock    = 0;
+    int               maxPages = 0; // 0: unlimited
+    qint64            maxBytes = 0; // 0: unlimited
+
+    explicit LazyPages(QStackedLayout* layout)
+        : QObject(layout)
+        , layout(layout)
+    {
+        setObjectName("nwidget::LazyPages");
+        connect(layout, &QStackedLayout::currentChanged, this, &LazyPages::show);
+    }
+
+    void show(int index)
+    {
+        const auto widget = layout->widget(index);
+        for (auto& page : pages) {
+            if (!widget || page.placeholder != widget)
+                continue;
+            if (!page.content) {
+                page.content = page.build();
+                page.placeholder->layout()->addWidget(page.content);
+                page.bytes = page.size ? page.size(page.content) : defaultSize(page.content);
+                connect(page.content, &QObject::destroyed, this, [this, c = page.content] { forget(c); });
+            }
+            page.lastUsed = ++clock;
+            break;
+        }
+        evict();
+    }
+
+    void evict()
+    {
+        const auto current = layout->currentWidget();
+        for (;;) {
+            int    built = 0;
+            qint64 bytes = 0;
+            Page*  lru   = nullptr;
+            for (auto& page : pages) {
+                if (!page.content)
+                    continue;
+                ++built;
+                bytes += page.bytes;
+                if (page.placeholder != current && (!lru || page.lastUsed < lru->lastUsed))
+                    lru = &page;
+            }
+
+            if (!lru || !((maxPages > 0 && built > maxPages) || (maxBytes > 0 && bytes > maxBytes)))
+                return;
+
+            delete lru->content; // rebuilt by its builder when shown again
+        }
+    }
+
+    void remove(QObject* placeholder)
+    {
+        pages.erase(std::remove_if(pages.begin(),
+                                   pages.end(),
+                                   [placeholder](const Page& page) { return page.placeholder == placeholder; }),
+                    pages.end());
+    }
+
+    void forget(QObject* content)
+    {
+        for (auto& page : pages)
+            if (page.content == content) {
+                page.content = nullptr;
+                page.bytes   = 0;
+            }
+    }
+
+    /// Rough estimate without a size function: 1 KiB per object of the page
+    static qint64 defaultSize(QWidget* content) { return (content->findChildren<QObject*>().size() + 1) * 1024; }
+};
+
+} // namespace impl::builders
+
+class StackedLayoutItem : public BuilderItem<QStackedLayout>
+{
+public:
+    using BuilderItem::BuilderItem;
+
+    template <typename Iterator, typename Generator>
+    StackedLayoutItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<StackedLayoutItem>(range))
+    {
+    }
+
+    StackedLayoutItem(QWidget* widget)
+        : BuilderItem([](const BuilderItem* item, QStackedLayout* l)
+                      { l->addWidget(static_cast<const StackedLayoutItem*>(item)->widget); })
+        , widget(widget)
+    {
+    }
+
+    template <typename Class, typename Self>
+    StackedLayoutItem(const Builder<Class, Self>& builder)
+        : StackedLayoutItem(builder.object())
+    {
+    }
+
+    enum class lazy { tag };
+    StackedLayoutItem(lazy, std::function<QWidget*()> build, std::function<qint64(QWidget*)> size)
+        : BuilderItem(
+              [](const BuilderItem* item, QStackedLayout* l)
+              {
+                  auto self = static_cast<const StackedLayoutItem*>(item);
+                  impl::builders::LazyPages::of(l)->add(self->build, self->size);
+              })
+        , build(std::move(build))
+        , size(std::move(size))
+    {
+    }
+
+private:
+    QWidget*                        widget = nullptr;
+    std::function<QWidget*()>       build;
+    std::function<qint64(QWidget*)> size;
+};
+
 template <typename Self> class Builder<QStackedLayout, Self> : public Builder<QLayout, Self>
 {
     N_BUILDER(QStackedLayout)
 
+    Builder(std::initializer_list<StackedLayoutItem> items) { self().addItems(items); }
+
+    /// Page built by build() when it is shown, size(page) estimates its memory in bytes for the page cache
+    static auto Lazy(std::function<QWidget*()> build, std::function<qint64(QWidget*)> size = {})
+    {
+        return StackedLayoutItem(StackedLayoutItem::lazy::tag, std::move(build), std::move(size));
+    }
+
     N_BUILDER_PROPERTY(currentIndex)
     N_BUILDER_PROPERTY(stackingMode)
 
     N_BUILDER_SETTER1(currentWidget, setCurrentWidget)
+
+    /// Delete the least recently used hidden lazy pages beyond maxPages built pages or maxBytes, 0 is unlimited
+    Self& pageCache(int maxPages, qint64 maxBytes = 0)
+    {
+        impl::builders::LazyPages::of(object())->setLimits(maxPages, maxBytes);
+        return self();
+    }
 };
 
 using StackedLayout = Builder<QStackedLayout>;
@@ -356,7 +825,7 @@ template <typename Self> class Builder<QWidget, Self> : public Builder<QObject,
     N_BUILDER_PROPERTY(maximumHeight)
     N_BUILDER_PROPERTY(sizeIncrement)
     N_BUILDER_PROPERTY(baseSize)
-    N_BUILDER_PROPERTY(alette)
+    N_BUILDER_PROPERTY(palette)
     N_BUILDER_PROPERTY(font)
 #ifndef QT_NO_CURSOR
     N_BUILDER_PROPERTY(cursor)
@@ -370,6 +839,7 @@ template <typename Self> class Builder<QWidget, Self> : public Builder<QObject,
     N_BUILDER_PROPERTY(acceptDrops)
     N_BUILDER_PROPERTY(windowTitle)
     N_BUILDER_PROPERTY(windowIcon)
+    Self& windowIcon(const QString& path) { return self().windowIcon(IconCache::icon(path)); }
     N_BUILDER_PROPERTY(windowIconText)
     N_BUILDER_PROPERTY(windowOpacity)
     N_BUILDER_PROPERTY(windowModified)
@@ -392,6 +862,13 @@ template <typename Self> class Builder<QWidget, Self> : public Builder<QObject,
     N_BUILDER_PROPERTY(autoFillBackground)
 #ifndef QT_NO_STYLE_STYLESHEET
     N_BUILDER_PROPERTY(styleSheet)
+
+    /// Style sheet shared with the widgets of the window using the same sheet, see stylesheet.h
+    Self& sharedStyleSheet(const QString& sheet)
+    {
+        StyleSheets::share(self().o, sheet);
+        return self();
+    }
 #endif
     N_BUILDER_PROPERTY(locale)
     N_BUILDER_PROPERTY(windowFilePath)
@@ -408,7 +885,6 @@ template <typename Self> class Builder<QWidget, Self> : public Builder<QObject,
     N_BUILDER_SETTERX(fixedSize, setFixedSize, int, int)
     N_BUILDER_SETTER1(fixedWidth, setFixedWidth)
     N_BUILDER_SETTER1(fixedHeight, setFixedHeight)
-    N_BUILDER_SETTER1(palette, setPalette)
     N_BUILDER_SETTER1(backgroundRole, setBackgroundRole)
     N_BUILDER_SETTER1(foregroundRole, setForegroundRole)
     N_BUILDER_SETTER1(mouseTracking, setMouseTracking)
@@ -450,6 +926,7 @@ template <typename Self> class Builder<QAbstractButton, Self> : public Builder<Q
 
     N_BUILDER_PROPERTY(text)
     N_BUILDER_PROPERTY(icon)
+    Self& icon(const QString& path) { return self().icon(IconCache::icon(path)); }
     N_BUILDER_PROPERTY(iconSize)
 #ifndef QT_NO_SHORTCUT
     N_BUILDER_PROPERTY(shortcut)
@@ -622,6 +1099,36 @@ template <typename Self> class Builder<QAbstractItemView, Self> : public Builder
     N_BUILDER_PROPERTY(horizontalScrollMode)
 
     N_BUILDER_SETTER1(model, setModel)
+
+    /// Show a container through a read-only ContainerModel, see models.h
+    template <typename Container,
+              typename Projection = impl::models::Identity,
+              typename = std::enable_if_t<!std::is_convertible_v<Container, QAbstractItemModel*>>>
+    Self& model(Container&& container, Projection projection = {})
+    {
+        object()->setModel(makeContainerModel(std::forward<Container>(container), std::move(projection), object()));
+        return self();
+    }
+
+    /// Show a container through a TableModel with the given columns, see models.h
+    template <typename Container, typename Getter, typename Setter, typename... Columns>
+    Self& model(Container&& container, impl::models::ColumnSpec<Getter, Setter> first, Columns... rest)
+    {
+        const auto model = makeTableModel(std::forward<Container>(container), std::move(first), std::move(rest)...);
+        model->setParent(object());
+        object()->setModel(model);
+        return self();
+    }
+
+    /// Show a container through a TableModel with a column set described once, see models.h
+    template <typename Container, typename... Columns>
+    Self& model(Container&& container, const TableColumns<Columns...>& columns)
+    {
+        const auto model = makeTableModel(std::forward<Container>(container), columns);
+        model->setParent(object());
+        object()->setModel(model);
+        return self();
+    }
 };
 
 using AbstractItemView = Builder<QAbstractItemView>;
@@ -733,12 +1240,105 @@ template <typename Self> class Builder<QTableView, Self> : public Builder<QAbstr
     N_BUILDER_SETTER2(rowHidden, setRowHidden)
     N_BUILDER_SETTER2(columnHidden, setColumnHidden)
     N_BUILDER_SETTER4(span, setSpan)
+
+    /// Show a CSV file through a CsvFileModel, see filemodels.h
+    Self& csvFile(const QString& path, char delimiter = ',', bool header = true)
+    {
+        object()->setModel(new CsvFileModel(path, delimiter, header, object()));
+        return self();
+    }
+
+    /// Show a file of fixed-size records through a RecordFileModel, see filemodels.h
+    Self& recordFile(const QString& path, int recordSize, const QList<RecordFileModel::Field>& fields)
+    {
+        object()->setModel(new RecordFileModel(path, recordSize, fields, object()));
+        return self();
+    }
+
+    /// Show the current model through a SortProxyModel and sort by clicking the header, see proxies.h
+    Self& parallelSorting()
+    {
+        const auto proxy = new SortProxyModel(object());
+        proxy->setSourceModel(object()->model());
+        object()->setModel(proxy);
+        object()->setSortingEnabled(true);
+        return self();
+    }
+
+    /// Show the rows of the current model containing the text of edit, e.g. a QLineEdit, see proxies.h
+    template <typename Edit> Self& filterBy(Edit* edit, const QList<int>& columns = {})
+    {
+        Q_ASSERT(edit);
+        const auto proxy = new FilterProxyModel(object());
+        proxy->setFilterColumns(columns);
+        proxy->setSourceModel(object()->model());
+        proxy->setFilterText(edit->text());
+        QObject::connect(edit, &Edit::textChanged, proxy, [proxy](const QString& text) { proxy->setFilterText(text); });
+        object()->setModel(proxy);
+        return self();
+    }
 };
 
 using TableView = Builder<QTableView>;
 #endif
 
 #ifdef QTABLEWIDGET_H
+namespace impl::builders {
+
+/// Fill a table widget without sorting and per-cell signals, views are notified once when done
+class TableWidgetFill
+{
+public:
+    TableWidgetFill(QTableWidget* table, int rows, int columns)
+        : table(table)
+        , sorting(table->isSortingEnabled())
+    {
+        table->setSortingEnabled(false);
+        table->setRowCount(qMax(table->rowCount(), rows));
+        table->setColumnCount(qMax(table->columnCount(), columns));
+        blocked = table->model()->blockSignals(true);
+    }
+
+    ~TableWidgetFill()
+    {
+        const auto model = table->model();
+        model->blockSignals(blocked);
+        if (model->rowCount() > 0 && model->columnCount() > 0) {
+            const QSignalBlocker blocker(table); // the views are notified, itemChanged is not emitted
+            emit model->dataChanged(model->index(0, 0),
+                                    model->index(model->rowCount() - 1, model->columnCount() - 1));
+        }
+        table->setSortingEnabled(sorting);
+    }
+
+    template <typename Column> void column(int col, const Column& data)
+    {
+        int row = 0;
+        for (const auto& value : data)
+            table->setItem(row++, col, item(value));
+    }
+
+private:
+    QTableWidget* table;
+    bool          sorting;
+    bool          blocked;
+
+    template <typename T> static QTableWidgetItem* item(const T& value)
+    {
+        if constexpr (std::is_convertible_v<const T&, QTableWidgetItem*>)
+            return value;
+        else if constexpr (std::is_convertible_v<const T&, QString>)
+            return new QTableWidgetItem(QString(value));
+        else {
+            const auto item = new QTableWidgetItem;
+            item->setData(Qt::DisplayRole, QVariant::fromValue(value));
+            return item;
+        }
+    }
+};
+
+} // namespace impl::builders
+
 template <typename Self> class Builder<QTableWidget, Self> : public Builder<QAbstractItemView, Self>
 {
     N_BUILDER(QTableWidget)
@@ -746,6 +1346,26 @@ template <typename Self> class Builder<QTableWidget, Self> : public Builder<QAbs
     N_BUILDER_PROPERTY(rowCount)
     N_BUILDER_PROPERTY(columnCount)
 
+    /// Fill the columns from 0 with one container of values each, e.g. QStringList, std::vector<int>
+    template <typename... Columns> Self& columns(const Columns&... data)
+    {
+        int rows = 0;
+        ((rows = qMax(rows, static_cast<int>(std::size(data)))), ...);
+
+        impl::builders::TableWidgetFill fill(object(), rows, sizeof...(Columns));
+        int                             col = 0;
+        (fill.column(col++, data), ...);
+        return self();
+    }
+
+    /// Fill column col with a container of values
+    template <typename Column> Self& column(int col, const Column& data)
+    {
+        impl::builders::TableWidgetFill fill(object(), static_cast<int>(std::size(data)), col + 1);
+        fill.column(col, data);
+        return self();
+    }
+
     N_BUILDER_SETTER3(item, setItem)
     N_BUILDER_SETTER2(verticalHeaderItem, setVerticalHeaderItem)
     N_BUILDER_SETTER2(horizontalHeaderItem, setHorizontalHeaderItem)
@@ -813,11 +1433,123 @@ using TreeView = Builder<QTreeView>;
 #endif
 
 #ifdef QTREEWIDGET_H
+namespace impl::builders {
+
+/// Tree widget item whose children are added when it is expanded for the first time
+class LazyTreeWidgetItem : public QTreeWidgetItem
+{
+public:
+    using Children = std::function<void(QTreeWidgetItem* parent)>;
+
+    LazyTreeWidgetItem(QTreeWidgetItem* parent, const QStringList& texts, Children children)
+        : QTreeWidgetItem(parent, texts)
+        , children(std::move(children))
+    {
+        setChildIndicatorPolicy(ShowIndicator);
+
+        const auto tree = treeWidget();
+        if (tree && !tree->findChild<QObject*>("nwidget::LazyTreeWidget", Qt::FindDirectChildrenOnly)) {
+            const auto watcher = new QObject(tree);
+            watcher->setObjectName("nwidget::LazyTreeWidget");
+            QObject::connect(tree, &QTreeWidget::itemExpanded, watcher, &LazyTreeWidgetItem::fetch);
+        }
+    }
+
+    static void fetch(QTreeWidgetItem* item)
+    {
+        const auto lazy = dynamic_cast<LazyTreeWidgetItem*>(item);
+        if (!lazy || !lazy->children)
+            return;
+
+        const auto children = std::move(lazy->children);
+        lazy->children      = nullptr;
+        children(lazy);
+        lazy->setChildIndicatorPolicy(DontShowIndicatorWhenChildless);
+    }
+
+private:
+    Children children;
+};
+
+} // namespace impl::builders
+
+class TreeWidgetItem : public BuilderItem<QTreeWidgetItem>
+{
+public:
+    using BuilderItem::BuilderItem;
+
+    template <typename Iterator, typename Generator>
+    TreeWidgetItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<TreeWidgetItem>(range))
+    {
+    }
+
+    TreeWidgetItem(const QStringList& texts, std::initializer_list<TreeWidgetItem> children = {})
+        : BuilderItem(
+              [](const BuilderItem* item, QTreeWidgetItem* parent)
+              {
+                  auto       self = static_cast<const TreeWidgetItem*>(item);
+                  const auto i    = new QTreeWidgetItem(parent, self->texts);
+                  for (const auto& child : self->children)
+                      addTo(child, i);
+              })
+        , texts(texts)
+        , children(children)
+    {
+    }
+
+    /// Children are generated when the item is expanded for the first time, children() returns a ForEach range or
+    /// a container of items
+    template <typename Children, typename = std::enable_if_t<std::is_invocable_v<Children&>>>
+    TreeWidgetItem(const QStringList& texts, Children children)
+        : BuilderItem(
+              [](const BuilderItem* item, QTreeWidgetItem* parent)
+              {
+                  auto self = static_cast<const TreeWidgetItem*>(item);
+                  new impl::builders::LazyTreeWidgetItem(parent, self->texts, self->lazy);
+              })
+        , texts(texts)
+        , lazy([children](QTreeWidgetItem* parent) mutable { addAll(children(), parent); })
+    {
+    }
+
+private:
+    QStringList                                  texts;
+    std::vector<TreeWidgetItem>                  children;
+    impl::builders::LazyTreeWidgetItem::Children lazy;
+
+    template <typename Items> static void addAll(Items&& items, QTreeWidgetItem* parent)
+    {
+        if constexpr (std::is_constructible_v<TreeWidgetItem, Items>)
+            addTo(TreeWidgetItem(std::forward<Items>(items)), parent);
+        else
+            for (auto&& item : items)
+                addTo(TreeWidgetItem(item), parent);
+    }
+};
+
 template <typename Self> class Builder<QTreeWidget, Self> : public Builder<QAbstractItemView, Self>
 {
     N_BUILDER(QTreeWidget)
 
+    Builder(std::initializer_list<TreeWidgetItem> items) { self().items(items); }
+
     N_BUILDER_PROPERTY(columnCount)
+
+    N_BUILDER_SETTER1(headerLabels, setHeaderLabels)
+
+    N_BUILDER_SIGNAL(onItemExpanded, itemExpanded)
+    N_BUILDER_SIGNAL(onItemCollapsed, itemCollapsed)
+    N_BUILDER_SIGNAL(onItemActivated, itemActivated)
+    N_BUILDER_SIGNAL(onCurrentItemChanged, currentItemChanged)
+
+    /// Add top level items
+    Self& items(std::initializer_list<TreeWidgetItem> items)
+    {
+        for (const auto& item : items)
+            item.func(&item, object()->invisibleRootItem());
+        return self();
+    }
 };
 
 using TreeWidget = Builder<QTreeWidget>;
@@ -845,6 +1577,13 @@ template <typename Self> class Builder<QPlainTextEdit, Self> : public Builder<QA
     N_BUILDER_PROPERTY(backgroundVisible)
     N_BUILDER_PROPERTY(centerOnScroll)
     N_BUILDER_PROPERTY(placeholderText)
+
+    /// Stream the content of path into the editor in time slices, see loaders.h
+    Self& loadFile(const QString& path, TextFileLoader::Progress progress = {})
+    {
+        TextFileLoader::load(object(), path, std::move(progress));
+        return self();
+    }
 };
 
 using PlainTextEdit = Builder<QPlainTextEdit>;
@@ -876,6 +1615,27 @@ template <typename Self> class Builder<QTextEdit, Self> : public Builder<QAbstra
     N_BUILDER_PROPERTY(document)
     N_BUILDER_PROPERTY(placeholderText)
 
+    /// Stream the content of path into the editor as plain text in time slices, see loaders.h
+    Self& loadFile(const QString& path, TextFileLoader::Progress progress = {})
+    {
+        TextFileLoader::load(object(), path, std::move(progress));
+        return self();
+    }
+
+    /// Parse html on a worker thread and show placeholder until it is ready, see loaders.h
+    Self& htmlAsync(const QString& html, const QString& placeholder = {})
+    {
+        DocumentLoader::load(object(), DocumentLoader::Html, html, placeholder);
+        return self();
+    }
+
+    /// Parse markdown on a worker thread and show placeholder until it is ready, see loaders.h
+    Self& markdownAsync(const QString& markdown, const QString& placeholder = {})
+    {
+        DocumentLoader::load(object(), DocumentLoader::Markdown, markdown, placeholder);
+        return self();
+    }
+
     N_BUILDER_SIGNAL(onTextChanged, textChanged)
     N_BUILDER_SIGNAL(onUndoAvailable, undoAvailable)
     N_BUILDER_SIGNAL(onRedoAvailable, redoAvailable)
@@ -915,8 +1675,19 @@ class ToolBoxItem : public BuilderItem<QToolBox>
 public:
     using BuilderItem::BuilderItem;
 
+    template <typename Iterator, typename Generator>
+    ToolBoxItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<ToolBoxItem>(range))
+    {
+    }
+
     ToolBoxItem(const QString& text, QWidget* widget)
-        : ToolBoxItem({}, text, widget)
+        : ToolBoxItem(QIcon(), text, widget)
+    {
+    }
+
+    ToolBoxItem(const QString& icon, const QString& text, QWidget* widget)
+        : ToolBoxItem(IconCache::icon(icon), text, widget)
     {
     }
 
@@ -959,6 +1730,12 @@ class SplitterItem : public BuilderItem<QSplitter>
 public:
     using BuilderItem::BuilderItem;
 
+    template <typename Iterator, typename Generator>
+    SplitterItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<SplitterItem>(range))
+    {
+    }
+
     SplitterItem(QWidget* item)
         : BuilderItem(
               [](const BuilderItem* item, QSplitter* splitter)
@@ -1170,6 +1947,12 @@ class QComboBoxItem : public BuilderItem<QComboBox>
 public:
     using BuilderItem::BuilderItem;
 
+    template <typename Iterator, typename Generator>
+    QComboBoxItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<QComboBoxItem>(range))
+    {
+    }
+
     template <typename T>
     QComboBoxItem(T&& text)
         : QComboBoxItem({}, std::forward<T>(text), {})
@@ -1223,6 +2006,18 @@ template <typename Self> class Builder<QComboBox, Self> : public Builder<QWidget
     N_BUILDER_PROPERTY(frame)
     N_BUILDER_PROPERTY(modelColumn)
 
+    N_BUILDER_SETTER1(model, setModel)
+
+    /// Show a container through a read-only ContainerModel, see models.h
+    template <typename Container,
+              typename Projection = impl::models::Identity,
+              typename = std::enable_if_t<!std::is_convertible_v<Container, QAbstractItemModel*>>>
+    Self& model(Container&& container, Projection projection = {})
+    {
+        object()->setModel(makeContainerModel(std::forward<Container>(container), std::move(projection), object()));
+        return self();
+    }
+
     N_BUILDER_SIGNAL(onEditTextChanged, editTextChanged)
     N_BUILDER_SIGNAL(onActivated, activated)
     N_BUILDER_SIGNAL(onTextActivated, textActivated)
@@ -1242,8 +2037,8 @@ template <typename Self> class Builder<QGroupBox, Self> : public Builder<QWidget
 
     // clang-format off
     explicit
-    Builder(const QString& title)                  { self().init( ).title(title); }
-    Builder(const QString& title, QLayout* layout) { self().init( ).title(title).layout(layout); }
+    Builder(const QString& title)                  { self().title(title); }
+    Builder(const QString& title, QLayout* layout) { self().title(title).layout(layout); }
     // clang-format on
 
     N_BUILDER_PROPERTY(title)
@@ -1272,7 +2067,14 @@ template <typename Self> class Builder<QLabel, Self> : public Builder<QWidget, S
     N_BUILDER_PROPERTY(margin)
     N_BUILDER_PROPERTY(indent)
     N_BUILDER_PROPERTY(openExternalLinks)
-    N_BUILDER_PROPERTY(InteractionFlags)
+    N_BUILDER_PROPERTY(textInteractionFlags)
+
+    /// Decode the image on the worker pool scaled down to fit into size, placeholder is shown until then
+    Self& imageAsync(const QString& path, const QSize& size, const QPixmap& placeholder = {})
+    {
+        const ImageSize decoded(size, object()->devicePixelRatioF());
+        return self().pixmap(Resources::pixmap(path, decoded, placeholder));
+    }
 };
 
 using Label = Builder<QLabel>;
@@ -1307,6 +2109,13 @@ template <typename Self> class Builder<QLineEdit, Self> : public Builder<QWidget
 #endif
 #if QT_CONFIG(completer)
     N_BUILDER_SETTER1(completer, setCompleter)
+
+    /// Complete with the first k entries of index starting with the text, see completer.h
+    Self& completer(std::shared_ptr<const PrefixIndex> index, int k = 10)
+    {
+        object()->setCompleter(new IndexCompleter(std::move(index), k, object()));
+        return self();
+    }
 #endif
 
     N_BUILDER_SIGNAL(onTextChanged, textChanged)
@@ -1322,11 +2131,68 @@ using LineEdit = Builder<QLineEdit>;
 #endif
 
 #ifdef QMENU_H
+namespace impl::builders {
+
+/// Call populate on the first aboutToShow of menu, or on every one with rebuild
+inline void populateOnShow(QMenu* menu, std::function<void(QMenu*)> populate, bool rebuild)
+{
+    QObject::connect(menu,
+                     &QMenu::aboutToShow,
+                     menu,
+                     [menu,
+                      populate  = std::move(populate),
+                      rebuild,
+                      populated = false,
+                      generated = QList<QAction*>()]() mutable
+                     {
+                         if (populated && !rebuild)
+                             return;
+
+                         // only the generated actions are released, other items of the menu stay
+                         const auto actions = menu->actions();
+                         const auto current = QSet<QAction*>(actions.cbegin(), actions.cend());
+                         for (const auto action : std::as_const(generated)) {
+                             if (!current.contains(action))
+                                 continue; // deleted elsewhere
+                             menu->removeAction(action);
+                             if (const auto sub = action->menu(); sub && sub->parent() == menu)
+                                 sub->deleteLater();
+                             else if (action->parent() == menu)
+                                 action->deleteLater();
+                         }
+                         generated.clear();
+
+                         const auto before = menu->actions();
+                         const auto kept   = QSet<QAction*>(before.cbegin(), before.cend());
+                         populated         = true;
+                         populate(menu);
+
+                         // generated actions and submenus are owned by the menu, to be released on rebuild
+                         for (const auto action : menu->actions()) {
+                             if (kept.contains(action))
+                                 continue;
+                             generated.append(action);
+                             if (!action->parent())
+                                 action->setParent(menu);
+                             if (const auto sub = action->menu(); sub && !sub->parent())
+                                 sub->setParent(menu, sub->windowFlags());
+                         }
+                     });
+}
+
+} // namespace impl::builders
+
 class MenuItem : public BuilderItem<QMenu>
 {
 public:
     using BuilderItem::BuilderItem;
 
+    template <typename Iterator, typename Generator>
+    MenuItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<MenuItem>(range))
+    {
+    }
+
     MenuItem(QAction* action)
         : BuilderItem([](const BuilderItem* item, QMenu* m)
                       { m->addAction(static_cast<QAction*>(static_cast<const MenuItem*>(item)->item)); })
@@ -1352,8 +2218,40 @@ public:
     {
     }
 
+    enum class lazy { tag };
+    template <typename Generator>
+    MenuItem(lazy, const QString& title, Generator gen, bool rebuildOnShow)
+        : BuilderItem(
+              [](const BuilderItem* item, QMenu* m)
+              {
+                  auto self = static_cast<const MenuItem*>(item);
+                  impl::builders::populateOnShow(m->addMenu(self->title), self->populate, self->rebuild);
+              })
+        , title(title)
+        , populate(populator(gen))
+        , rebuild(rebuildOnShow)
+    {
+    }
+
+    /// Function adding the items returned by gen() to a menu, gen returns a ForEach range or a container of items
+    template <typename Generator> static std::function<void(QMenu*)> populator(Generator gen)
+    {
+        return [gen](QMenu* menu) mutable
+        {
+            auto&& items = gen();
+            if constexpr (std::is_constructible_v<MenuItem, decltype(items)>)
+                addTo(MenuItem(std::forward<decltype(items)>(items)), menu);
+            else
+                for (auto&& item : items)
+                    addTo(MenuItem(item), menu);
+        };
+    }
+
 private:
-    QObject* item;
+    QObject*                    item = nullptr;
+    QString                     title;
+    std::function<void(QMenu*)> populate;
+    bool                        rebuild = false;
 };
 
 template <typename Self> class Builder<QMenu, Self> : public Builder<QWidget, Self>
@@ -1364,13 +2262,27 @@ template <typename Self> class Builder<QMenu, Self> : public Builder<QWidget, Se
 
     static auto Separator() { return MenuItem(MenuItem::separator::tag); }
 
+    /// Submenu whose items are generated on its first aboutToShow, or on every one with rebuildOnShow
+    template <typename Generator> static auto Lazy(const QString& title, Generator gen, bool rebuildOnShow = false)
+    {
+        return MenuItem(MenuItem::lazy::tag, title, gen, rebuildOnShow);
+    }
+
     N_BUILDER_PROPERTY(tearOffEnabled)
     N_BUILDER_PROPERTY(title)
     N_BUILDER_PROPERTY(icon)
+    Self& icon(const QString& path) { return self().icon(IconCache::icon(path)); }
     N_BUILDER_PROPERTY(separatorsCollapsible)
     N_BUILDER_PROPERTY(toolTipsVisible)
 
     Self& items(std::initializer_list<MenuItem> items) { return self().addItems(items); }
+
+    /// Generate the items on the first aboutToShow, or on every one with rebuildOnShow
+    template <typename Generator> Self& lazyItems(Generator gen, bool rebuildOnShow = false)
+    {
+        impl::builders::populateOnShow(object(), MenuItem::populator(gen), rebuildOnShow);
+        return self();
+    }
 };
 
 using Menu = Builder<QMenu>;
@@ -1382,6 +2294,12 @@ class MenuBarItem : public BuilderItem<QMenuBar>
 public:
     using BuilderItem::BuilderItem;
 
+    template <typename Iterator, typename Generator>
+    MenuBarItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<MenuBarItem>(range))
+    {
+    }
+
     MenuBarItem(QAction* action)
         : BuilderItem([](const BuilderItem* item, QMenuBar* m)
                       { m->addAction(static_cast<QAction*>(static_cast<const MenuBarItem*>(item)->item)); })
@@ -1442,8 +2360,19 @@ class TabBarItem : public BuilderItem<QTabBar>
 public:
     using BuilderItem::BuilderItem;
 
+    template <typename Iterator, typename Generator>
+    TabBarItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<TabBarItem>(range))
+    {
+    }
+
     TabBarItem(const QString& text)
-        : TabBarItem({}, text)
+        : TabBarItem(QIcon(), text)
+    {
+    }
+
+    TabBarItem(const QString& icon, const QString& text)
+        : TabBarItem(IconCache::icon(icon), text)
     {
     }
 
@@ -1516,12 +2445,23 @@ class TabWidgetItem : public BuilderItem<QTabWidget>
 public:
     using BuilderItem::BuilderItem;
 
+    template <typename Iterator, typename Generator>
+    TabWidgetItem(ForEachRange<Iterator, Generator> range)
+        : BuilderItem(expand<TabWidgetItem>(range))
+    {
+    }
+
     TabWidgetItem(const QString& text, QWidget* page)
-        : TabWidgetItem({}, text, page)
+        : TabWidgetItem(QIcon(), text, page)
     {
     }
 
     TabWidgetItem(const QString& icon, const QString& text, QWidget* page)
+        : TabWidgetItem(IconCache::icon(icon), text, page)
+    {
+    }
+
+    TabWidgetItem(const QIcon& icon, const QString& text, QWidget* page)
         : BuilderItem(
               [](const BuilderItem* item, QTabWidget* tab)
               {
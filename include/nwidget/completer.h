@@ -0,0 +1,192 @@
+/**
+ * @brief Prefix completion over millions of entries
+ * @details
+ * A PrefixIndex keeps the entries as UTF-8 in one buffer, or in a memory-mapped file, and a sorted array of their
+ * offsets. A completion is a binary search for the prefix followed by reading the first k matches:
+ *      @code{.cpp}
+ *      const auto cities = PrefixIndex::fromFile("cities.txt"); // one entry per line
+ *
+ *      QLayout* layout = VBoxLayout{
+ *          LineEdit().completer(cities, 20),
+ *      };
+ *      @endcode
+ *
+ * Notes:
+ *      - Matching is case-insensitive for ASCII letters, other characters are compared by their UTF-8 bytes.
+ *      - Matches are returned in sorted order. A file which is already sorted this way, e.g. written by save(), is
+ *        indexed with a single scan, other files are sorted once when loaded.
+ *      - The index is immutable and can be shared between line edits and threads.
+ */
+
+#ifndef NWIDGET_COMPLETER_H
+#define NWIDGET_COMPLETER_H
+
+#include "mappedfile.h"
+
+#include <QCompleter>
+#include <QFile>
+#include <QLineEdit>
+#include <QStringListModel>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace nwidget {
+
+class PrefixIndex
+{
+public:
+    static std::shared_ptr<const PrefixIndex> fromStrings(const QStringList& entries)
+    {
+        std::shared_ptr<PrefixIndex> index(new PrefixIndex);
+        for (const auto& entry : entries) {
+            const auto utf8 = entry.toUtf8();
+            if (utf8.isEmpty())
+                continue;
+            index->entries.push_back({index->storage.size(), static_cast<quint32>(utf8.size())});
+            index->storage += utf8;
+        }
+        index->data = index->storage.constData();
+        index->sort();
+        return index;
+    }
+
+    /// Index the lines of a UTF-8 file, which is memory-mapped if possible
+    static std::shared_ptr<const PrefixIndex> fromFile(const QString& path)
+    {
+        std::shared_ptr<PrefixIndex> index(new PrefixIndex);
+        index->file.emplace(path);
+        index->data = index->file->data();
+
+        bool       sorted = true;
+        qint64     begin  = 0;
+        const auto end    = index->file->size();
+        while (begin < end) {
+            const auto nl     = static_cast<const char*>(std::memchr(index->data + begin, '\n', end - begin));
+            const auto stop   = nl ? nl - index->data : end;
+            auto       length = stop - begin;
+            if (length > 0 && index->data[begin + length - 1] == '\r')
+                --length;
+            if (length > 0) {
+                const Entry e{begin, static_cast<quint32>(length)};
+                if (sorted && !index->entries.empty() && index->less(e, index->entries.back()))
+                    sorted = false;
+                index->entries.push_back(e);
+            }
+            begin = stop + 1;
+        }
+
+        if (!sorted)
+            index->sort();
+        return index;
+    }
+
+    qsizetype size() const { return static_cast<qsizetype>(entries.size()); }
+
+    QString at(qsizetype i) const { return QString::fromUtf8(data + entries[i].offset, entries[i].length); }
+
+    /// The first k entries starting with prefix
+    QStringList complete(const QString& prefix, int k) const
+    {
+        const auto p  = prefix.toUtf8();
+        auto       it = std::lower_bound(entries.begin(),
+                                   entries.end(),
+                                   p,
+                                   [this](const Entry& e, const QByteArray& key)
+                                   { return compare(data + e.offset, e.length, key.constData(), key.size()) < 0; });
+
+        QStringList result;
+        for (; it != entries.end() && result.size() < k; ++it) {
+            if (qsizetype(it->length) < p.size() || compare(data + it->offset, p.size(), p.constData(), p.size()) != 0)
+                break;
+            result.append(QString::fromUtf8(data + it->offset, it->length));
+        }
+        return result;
+    }
+
+    /// Write the entries in sorted order, one per line, to be loaded again with a single scan
+    bool save(const QString& path) const
+    {
+        QFile out(path);
+        if (!out.open(QIODevice::WriteOnly))
+            return false;
+        for (const auto& e : entries) {
+            out.write(data + e.offset, e.length);
+            out.putChar('\n');
+        }
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        qint64  offset;
+        quint32 length;
+    };
+
+    std::optional<impl::mappedfile::MappedFile> file;
+    QByteArray                                  storage; // entries which are not read from a file
+    const char*                                 data = nullptr;
+    std::vector<Entry>                          entries;
+
+    PrefixIndex() = default;
+
+    static int compare(const char* a, qsizetype an, const char* b, qsizetype bn)
+    {
+        const auto fold = [](char c) { return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c; };
+        const auto n    = std::min(an, bn);
+        for (qsizetype i = 0; i < n; ++i) {
+            const auto x = static_cast<unsigned char>(fold(a[i]));
+            const auto y = static_cast<unsigned char>(fold(b[i]));
+            if (x != y)
+                return x < y ? -1 : 1;
+        }
+        return an < bn ? -1 : an > bn ? 1 : 0;
+    }
+
+    bool less(const Entry& a, const Entry& b) const
+    {
+        return compare(data + a.offset, a.length, data + b.offset, b.length) < 0;
+    }
+
+    void sort()
+    {
+        std::sort(entries.begin(), entries.end(), [this](const Entry& a, const Entry& b) { return less(a, b); });
+    }
+};
+
+/// Completer showing the first matches of a PrefixIndex, the matches are looked up on each edit
+class IndexCompleter : public QCompleter
+{
+public:
+    IndexCompleter(std::shared_ptr<const PrefixIndex> index, int k, QLineEdit* edit)
+        : QCompleter(edit)
+        , index(std::move(index))
+        , k(k)
+        , matches(new QStringListModel(this))
+    {
+        setObjectName("nwidget::IndexCompleter");
+        setModel(matches);
+        setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+        setCaseSensitivity(Qt::CaseInsensitive);
+
+        // textEdited is emitted before the line edit asks the completer to complete
+        connect(edit,
+                &QLineEdit::textEdited,
+                this,
+                [this](const QString& text)
+                { matches->setStringList(text.isEmpty() ? QStringList() : this->index->complete(text, this->k)); });
+    }
+
+private:
+    std::shared_ptr<const PrefixIndex> index;
+    int                                k;
+    QStringListModel*                  matches;
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_COMPLETER_H
@@ -0,0 +1,397 @@
+/**
+ * @brief Table models reading large CSV and fixed-size record files in place
+ * @details
+ * The file is memory-mapped and nothing is converted until a view asks for a cell. The rows of a CSV file are
+ * indexed on QThreadPool::globalInstance() and appended to the model in batches while the view is already usable:
+ *      @code{.cpp}
+ *      QLayout* layout = VBoxLayout{
+ *          TableView().csvFile("trades.csv"), // several GB
+ *          TableView().csvFile("prices.tsv", '\t', false),
+ *      };
+ *
+ *      // records of 16 bytes, an int id at offset 0 and a double price at offset 8
+ *      TableView().recordFile("prices.bin",
+ *                             16,
+ *                             {
+ *                                 {"Id", 0, RecordFileModel::Int32},
+ *                                 {"Price", 8, RecordFileModel::Float64},
+ *                             });
+ *      @endcode
+ *
+ * Notes:
+ *      - CSV files are read as UTF-8, quoted fields may contain delimiters, newlines and doubled quotes.
+ *      - A field is quoted only if it starts with a quote, quotes inside an unquoted field are kept as data.
+ *      - The number of columns is taken from the first line, which holds the titles unless there is no header.
+ *      - Models show at most INT_MAX rows.
+ *      - Records are read little-endian, string fields are Latin-1 and end at the first NUL byte.
+ *      - Files which cannot be mapped, e.g. resources, are read into memory.
+ *      - The models are read-only, the file must not change while it is shown.
+ */
+
+#ifndef NWIDGET_FILEMODELS_H
+#define NWIDGET_FILEMODELS_H
+
+#include "mappedfile.h"
+
+#include <QAbstractTableModel>
+#include <QThreadPool>
+#include <QtEndian>
+
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define N_IMPL_FILEMODELS_SSE2
+#endif
+
+namespace nwidget {
+
+namespace impl::filemodels {
+
+/// First byte in [begin, end) equal to a or b, end if there is none
+inline const char* find(const char* begin, const char* end, char a, char b)
+{
+#ifdef N_IMPL_FILEMODELS_SSE2
+    const auto va = _mm_set1_epi8(a);
+    const auto vb = _mm_set1_epi8(b);
+    for (; end - begin >= 16; begin += 16) {
+        const auto v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const auto mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)));
+        if (mask) {
+            int i = 0;
+            while (!(mask & (1 << i)))
+                ++i;
+            return begin + i;
+        }
+    }
+#endif
+    for (; begin != end; ++begin)
+        if (*begin == a || *begin == b)
+            return begin;
+    return end;
+}
+
+} // namespace impl::filemodels
+
+/// Read-only model of a CSV file, rows are indexed in the background, see filemodels.h
+class CsvFileModel : public QAbstractTableModel
+{
+public:
+    explicit CsvFileModel(const QString& path, char delimiter = ',', bool header = true, QObject* parent = nullptr)
+        : QAbstractTableModel(parent)
+        , file(path)
+        , delimiter(delimiter)
+    {
+        setObjectName("nwidget::CsvFileModel");
+
+        const auto begin = file.data();
+        const auto end   = begin + file.size();
+        if (file.size() == 0) {
+            indexed = true;
+            finished.set_value();
+            return;
+        }
+
+        // the first line determines the columns and the titles
+        std::vector<Field> first;
+        const auto         newline = rowEnd(begin, end);
+        fields(begin, newline, first);
+        columns = static_cast<int>(first.size());
+        if (header) {
+            for (const auto& field : first)
+                titles.append(decode(field));
+            starts.push_back(std::min(newline + 1, end) - begin);
+        } else
+            starts.push_back(0);
+
+        scan.reset(QRunnable::create([this, from = starts.back(), cancel = cancelled] { scanRows(from, cancel); }));
+        scan->setAutoDelete(false);
+        QThreadPool::globalInstance()->start(scan.get());
+    }
+
+    ~CsvFileModel() override
+    {
+        *cancelled = true;
+        // a scan which has not started is taken back, a running one reads the mapped file
+        if (scan && !QThreadPool::globalInstance()->tryTake(scan.get()))
+            finished.get_future().wait();
+    }
+
+    /// Whether all rows have been indexed
+    bool isIndexed() const { return indexed; }
+
+    int rowCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(qMin<qint64>(qint64(starts.size()) - 1, INT_MAX));
+    }
+
+    int columnCount(const QModelIndex& parent = {}) const override { return parent.isValid() ? 0 : columns; }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+    {
+        if (role != Qt::DisplayRole || !checkIndex(index, CheckIndexOption::IndexIsValid))
+            return {};
+
+        // views ask for the cells of a row one after another, its fields are split once
+        if (index.row() != cachedRow) {
+            const auto begin = file.data() + starts[index.row()];
+            const auto end   = file.data() + starts[index.row() + 1] - 1; // without the newline
+            fields(begin, end, cachedFields);
+            cachedRow = index.row();
+        }
+        if (index.column() >= static_cast<int>(cachedFields.size()))
+            return {};
+        return decode(cachedFields[index.column()]);
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+    {
+        if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < titles.size())
+            return titles[section];
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+private:
+    struct Field
+    {
+        const char* begin;
+        const char* end;
+        bool        quoted;
+    };
+
+    static constexpr int batchSize = 64 * 1024;
+
+    impl::mappedfile::MappedFile       file;
+    char                               delimiter;
+    int                                columns = 0;
+    QStringList                        titles;
+    std::vector<qint64>                starts; // row i spans [starts[i], starts[i + 1] - 1)
+    bool                               indexed   = false;
+    std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
+    std::promise<void>                 finished;
+    std::unique_ptr<QRunnable>         scan;
+    mutable std::vector<Field>         cachedFields;
+    mutable int                        cachedRow = -1;
+
+    /// The closing quote of the quoted part starting at quote, or end, doubled quotes are part of the field
+    static const char* closingQuote(const char* quote, const char* end)
+    {
+        for (auto p = quote + 1;; p += 2) {
+            p = impl::filemodels::find(p, end, '"', '"');
+            if (p == end || p + 1 == end || p[1] != '"')
+                return p;
+        }
+    }
+
+    /// The newline ending the row at begin, or end, skipping newlines in quoted fields
+    const char* rowEnd(const char* begin, const char* end) const
+    {
+        for (auto p = begin;; ++p) {
+            p = impl::filemodels::find(p, end, '\n', '"');
+            if (p == end || *p == '\n')
+                return p;
+            // only a quote at the start of a field quotes it, other quotes are data
+            if (p == begin || p[-1] == delimiter) {
+                p = closingQuote(p, end);
+                if (p == end)
+                    return end;
+            }
+        }
+    }
+
+    void fields(const char* begin, const char* end, std::vector<Field>& result) const
+    {
+        if (end > begin && end[-1] == '\r')
+            --end;
+
+        result.clear();
+        for (auto field = begin;;) {
+            auto       p      = field;
+            const auto quoted = p != end && *p == '"';
+            if (quoted) {
+                p = closingQuote(p, end);
+                if (p != end)
+                    ++p;
+            }
+            p = impl::filemodels::find(p, end, delimiter, delimiter);
+
+            result.push_back({field, p, quoted});
+            if (p == end)
+                return;
+            field = p + 1;
+        }
+    }
+
+    static QString decode(const Field& field)
+    {
+        if (!field.quoted)
+            return QString::fromUtf8(field.begin, field.end - field.begin);
+
+        auto begin = field.begin + 1;
+        auto end   = field.end;
+        if (end > begin && end[-1] == '"')
+            --end;
+        return QString::fromUtf8(begin, end - begin).replace(QLatin1String("\"\""), QLatin1String("\""));
+    }
+
+    /// Runs on the worker pool, the rows found are appended on the GUI thread in batches
+    void scanRows(qint64 from, std::shared_ptr<std::atomic<bool>> cancel)
+    {
+        const auto data = file.data();
+        const auto end  = data + file.size();
+
+        std::vector<qint64> batch;
+        batch.reserve(batchSize);
+        for (auto p = data + from; p < end && !*cancel;) {
+            p = rowEnd(p, end);
+            batch.push_back(std::min(p + 1, end + 1) - data); // a last line without newline ends at the file end
+            p += 1;
+
+            if (batch.size() == batchSize || p >= end) {
+                append(std::move(batch), p >= end);
+                batch = {};
+                batch.reserve(batchSize);
+            }
+        }
+        if (from >= file.size())
+            append({}, true);
+        finished.set_value();
+    }
+
+    void append(std::vector<qint64> batch, bool last)
+    {
+        // queued to this model, the call is dropped if the model is destroyed first
+        QMetaObject::invokeMethod(
+            this,
+            [this, batch = std::move(batch), last]
+            {
+                // rows beyond INT_MAX cannot be addressed by a model index and are left out
+                const auto first = rowCount();
+                const auto count = static_cast<int>(qMin<qint64>(qint64(batch.size()), INT_MAX - qint64(first)));
+                if (count > 0) {
+                    beginInsertRows({}, first, first + count - 1);
+                    starts.insert(starts.end(), batch.begin(), batch.begin() + count);
+                    endInsertRows();
+                }
+                indexed = last;
+            },
+            Qt::QueuedConnection);
+    }
+};
+
+/// Read-only model of a file of fixed-size binary records, see filemodels.h
+class RecordFileModel : public QAbstractTableModel
+{
+public:
+    enum Type { Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float32, Float64, Latin1 };
+
+    struct Field
+    {
+        QString title;
+        int     offset;
+        Type    type;
+        int     length = 0; // bytes of a Latin1 field
+    };
+
+    RecordFileModel(const QString& path, int recordSize, const QList<Field>& fields, QObject* parent = nullptr)
+        : QAbstractTableModel(parent)
+        , file(path)
+        , recordSize(recordSize)
+    {
+        setObjectName("nwidget::RecordFileModel");
+
+        if (recordSize <= 0) {
+            qWarning("nwidget::RecordFileModel: invalid record size %d", recordSize);
+            return;
+        }
+
+        // fields are read without further checks, each one has to lie within a record
+        for (const auto& field : fields) {
+            const auto width = field.type == Latin1 ? field.length : this->width(field.type);
+            if (field.offset < 0 || width <= 0 || qint64(field.offset) + width > recordSize)
+                qWarning("nwidget::RecordFileModel: field %s exceeds the record and is dropped",
+                         qPrintable(field.title));
+            else
+                this->fields.append(field);
+        }
+    }
+
+    int rowCount(const QModelIndex& parent = {}) const override
+    {
+        if (parent.isValid() || recordSize <= 0)
+            return 0;
+        return static_cast<int>(qMin<qint64>(file.size() / recordSize, INT_MAX));
+    }
+
+    int columnCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(fields.size());
+    }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+    {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid))
+            return {};
+
+        const auto& field = fields[index.column()];
+        if (role == Qt::TextAlignmentRole && field.type != Latin1)
+            return QVariant::fromValue(Qt::Alignment(Qt::AlignRight | Qt::AlignVCenter));
+        if (role != Qt::DisplayRole)
+            return {};
+
+        const auto p = file.data() + qint64(index.row()) * recordSize + field.offset;
+        switch (field.type) {
+        case Int8: return int(qint8(*p));
+        case UInt8: return int(quint8(*p));
+        case Int16: return qFromLittleEndian<qint16>(p);
+        case UInt16: return qFromLittleEndian<quint16>(p);
+        case Int32: return qFromLittleEndian<qint32>(p);
+        case UInt32: return qFromLittleEndian<quint32>(p);
+        case Int64: return qFromLittleEndian<qint64>(p);
+        case UInt64: return qFromLittleEndian<quint64>(p);
+        case Float32: return qFromLittleEndian<float>(p);
+        case Float64: return qFromLittleEndian<double>(p);
+        case Latin1: return QString::fromLatin1(p, qstrnlen(p, field.length));
+        }
+        return {};
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+    {
+        if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < fields.size())
+            return fields[section].title;
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+private:
+    impl::mappedfile::MappedFile file;
+    int                          recordSize;
+    QList<Field>                 fields;
+
+    static int width(Type type)
+    {
+        switch (type) {
+        case Int8:
+        case UInt8: return 1;
+        case Int16:
+        case UInt16: return 2;
+        case Int32:
+        case UInt32:
+        case Float32: return 4;
+        case Int64:
+        case UInt64:
+        case Float64: return 8;
+        case Latin1: break;
+        }
+        return 0;
+    }
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_FILEMODELS_H
@@ -0,0 +1,178 @@
+/**
+ * @brief Process-wide icon cache shared by the builders
+ * @details
+ * Builder icon properties and items accept a file path, call sites with the same path share one icon, and its
+ * rasterized pixmaps are cached by path, size, device pixel ratio and mode:
+ *      @code{.cpp}
+ *      QLayout* layout = VBoxLayout{
+ *          PushButton("Open").icon(":/icons/open.svg"),
+ *          ToolButton().icon(":/icons/open.svg"), // same icon, rasterized once per size
+ *      };
+ *
+ *      IconCache::setMaxCost(16 * 1024 * 1024); // bytes of cached pixmaps, least recently used ones are evicted
+ *      @endcode
+ *
+ * Notes:
+ *      - Images are decoded at the requested size with QImageReader, SVG icons are rendered at that size.
+ *      - Disabled, active and selected pixmaps are generated from the normal one like for other icons.
+ *      - The cache is used from the GUI thread only.
+ */
+
+#ifndef NWIDGET_ICONS_H
+#define NWIDGET_ICONS_H
+
+#include <QCache>
+#include <QHash>
+#include <QIcon>
+#include <QIconEngine>
+#include <QImageReader>
+#include <QPainter>
+#include <QPixmap>
+
+namespace nwidget {
+
+class IconCache
+{
+public:
+    /// Icon of path, shared between call sites, a null icon for an empty path
+    static QIcon icon(const QString& path);
+
+    /// Pixmap of path fitting into size at dpr, cached until evicted
+    static QPixmap pixmap(const QString& path,
+                          const QSize&   size,
+                          qreal          dpr,
+                          QIcon::Mode    mode  = QIcon::Normal,
+                          QIcon::State   state = QIcon::Off)
+    {
+        const auto key = QStringLiteral("%1:%2x%3@%4:%5")
+                             .arg(path)
+                             .arg(size.width())
+                             .arg(size.height())
+                             .arg(dpr)
+                             .arg(mode * 2 + state);
+        if (const auto cached = pixmaps().object(key))
+            return *cached;
+
+        QPixmap pm;
+        if (mode == QIcon::Normal)
+            pm = rasterize(path, size, dpr);
+        else // let the style generate the pixmap from the normal one, as QIcon does
+            pm = QIcon(pixmap(path, size, dpr)).pixmap(size, dpr, mode, state);
+
+        const auto cost = qMax<qsizetype>(1, qsizetype(pm.width()) * pm.height() * pm.depth() / 8);
+        pixmaps().insert(key, new QPixmap(pm), cost);
+        return pm;
+    }
+
+    /// Maximum bytes of cached pixmaps, 32 MiB by default
+    static void setMaxCost(qsizetype bytes) { pixmaps().setMaxCost(bytes); }
+
+    static void clear()
+    {
+        pixmaps().clear();
+        icons().clear();
+    }
+
+private:
+    static QCache<QString, QPixmap>& pixmaps()
+    {
+        static QCache<QString, QPixmap> cache(32 * 1024 * 1024);
+        return cache;
+    }
+
+    static QHash<QString, QIcon>& icons()
+    {
+        static QHash<QString, QIcon> cache;
+        return cache;
+    }
+
+    static QPixmap rasterize(const QString& path, const QSize& size, qreal dpr)
+    {
+        QImageReader reader(path);
+        reader.setAutoTransform(true);
+
+        auto scaled = reader.size();
+        if (scaled.isValid()) {
+            scaled.scale(size * dpr, Qt::KeepAspectRatio);
+            reader.setScaledSize(scaled);
+        }
+
+        auto pm = QPixmap::fromImage(reader.read());
+        pm.setDevicePixelRatio(dpr);
+        return pm;
+    }
+};
+
+namespace impl::icons {
+
+class Engine : public QIconEngine
+{
+public:
+    explicit Engine(const QString& path)
+        : path(path)
+    {
+        QImageReader reader(path);
+        natural  = reader.size();
+        scalable = reader.format().startsWith("svg");
+    }
+
+    QPixmap pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) override
+    {
+        return scaledPixmap(size, mode, state, 1);
+    }
+
+    QPixmap scaledPixmap(const QSize& size, QIcon::Mode mode, QIcon::State state, qreal scale) override
+    {
+        return IconCache::pixmap(path, actualSize(size, mode, state), scale, mode, state);
+    }
+
+    void paint(QPainter* painter, const QRect& rect, QIcon::Mode mode, QIcon::State state) override
+    {
+        const auto pm = scaledPixmap(rect.size(), mode, state, painter->device()->devicePixelRatioF());
+        auto       r  = QRect(QPoint(), pm.size() / pm.devicePixelRatio());
+        r.moveCenter(rect.center());
+        painter->drawPixmap(r, pm);
+    }
+
+    QSize actualSize(const QSize& size, QIcon::Mode, QIcon::State) override
+    {
+        if (!natural.isValid())
+            return size;
+        // bitmaps are only scaled down
+        if (!scalable && natural.width() <= size.width() && natural.height() <= size.height())
+            return natural;
+        return natural.scaled(size, Qt::KeepAspectRatio);
+    }
+
+    QList<QSize> availableSizes(QIcon::Mode = QIcon::Normal, QIcon::State = QIcon::Off) override
+    {
+        return natural.isValid() ? QList<QSize>{natural} : QList<QSize>{};
+    }
+
+    bool isNull() override { return !natural.isValid(); }
+
+    QString      key() const override { return QStringLiteral("nwidget"); }
+    QIconEngine* clone() const override { return new Engine(*this); }
+
+private:
+    QString path;
+    QSize   natural;
+    bool    scalable = false;
+};
+
+} // namespace impl::icons
+
+inline QIcon IconCache::icon(const QString& path)
+{
+    if (path.isEmpty())
+        return {};
+
+    auto it = icons().constFind(path);
+    if (it == icons().cend())
+        it = icons().insert(path, QIcon(new impl::icons::Engine(path)));
+    return *it;
+}
+
+} // namespace nwidget
+
+#endif // NWIDGET_ICONS_H
@@ -0,0 +1,169 @@
+/**
+ * @brief Add the items of builders in time slices to keep the event loop responsive
+ * @details
+ * While an IncrementalBuild is in scope, builders do not add their items at once. The items are added from the
+ * event loop in slices of at most the time budget, ForEach generators are called one item at a time:
+ *      @code{.cpp}
+ *      QWidget* list;
+ *      {
+ *          IncrementalBuild build(std::chrono::milliseconds(8));
+ *          list = Widget(VBoxLayout{
+ *              ForEach(0, 10000, [](int i) { return new QLabel(QString::number(i)); }),
+ *          });
+ *          build.root(list, false).onFinished([list] { list->setEnabled(true); });
+ *      }
+ *      list->show(); // filled while the event loop runs
+ *      @endcode
+ *
+ * Notes:
+ *      - Items passed to a builder directly, e.g. Label("text"), are created when the expression is evaluated, only
+ *        adding them is deferred. Items produced by ForEach are created when their slice runs.
+ *      - ForEach iterates an lvalue container when the slice runs, so the container must outlive the build and must
+ *        not be modified before. Temporary containers and initializer lists are moved or copied into the range.
+ *      - Items keep the order in which they are written, nested builders are completed before the next item.
+ *      - Without a root, the objects being built must outlive the build. With a root, the build stops when the root
+ *        is destroyed.
+ *      - The completion callback is always called from the event loop, also if there was nothing to add.
+ */
+
+#ifndef NWIDGET_INCREMENTAL_H
+#define NWIDGET_INCREMENTAL_H
+
+#include "builder.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QWidget>
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace nwidget {
+
+namespace impl::incremental {
+
+class Runner : public QObject, public impl::builder::Scheduler
+{
+public:
+    explicit Runner(std::chrono::milliseconds budget)
+        : QObject(QCoreApplication::instance())
+        , budget(budget)
+    {
+        setObjectName("nwidget::IncrementalBuild");
+    }
+
+    void post(std::function<bool()> step) override { steps.push_back(std::move(step)); }
+
+    void schedule()
+    {
+        QMetaObject::invokeMethod(this, [this] { slice(); }, Qt::QueuedConnection);
+    }
+
+    std::chrono::milliseconds budget;
+    std::function<void()>     finished;
+    QPointer<QWidget>         root;
+    bool                      hasRoot     = false;
+    bool                      progressive = true;
+
+private:
+    std::vector<std::function<bool()>> steps;
+
+    void slice()
+    {
+        if (hasRoot && !root) {
+            deleteLater();
+            return;
+        }
+
+        auto&      current = impl::builder::Scheduler::current();
+        const auto outer   = current;
+        current            = this;
+
+        QElapsedTimer timer;
+        timer.start();
+        while (!steps.empty() && timer.elapsed() < budget.count()) {
+            // steps posted by the running step are pushed above it and run before it resumes
+            const auto i    = steps.size() - 1;
+            auto       step = std::move(steps[i]);
+            const auto more = step();
+            if (hasRoot && !root) {
+                steps.clear();
+                break;
+            }
+            if (more)
+                steps[i] = std::move(step);
+            else
+                steps.erase(steps.begin() + i);
+        }
+
+        current = outer;
+
+        if (hasRoot && !root)
+            deleteLater();
+        else if (steps.empty())
+            finish();
+        else
+            schedule();
+    }
+
+    void finish()
+    {
+        if (root && !progressive)
+            root->setUpdatesEnabled(true);
+        if (finished)
+            finished();
+        deleteLater();
+    }
+};
+
+} // namespace impl::incremental
+
+/// Add the items of the builders in this scope in time slices, see incremental.h
+class IncrementalBuild
+{
+public:
+    explicit IncrementalBuild(std::chrono::milliseconds budget = std::chrono::milliseconds(8))
+        : runner(new impl::incremental::Runner(budget))
+        , outer(impl::builder::Scheduler::current())
+    {
+        impl::builder::Scheduler::current() = runner;
+    }
+
+    ~IncrementalBuild()
+    {
+        impl::builder::Scheduler::current() = outer;
+        runner->schedule();
+    }
+
+    IncrementalBuild(const IncrementalBuild&)            = delete;
+    IncrementalBuild& operator=(const IncrementalBuild&) = delete;
+
+    /// Stop when root is destroyed, without progressive display root is not repainted until the build finished
+    IncrementalBuild& root(QWidget* root, bool progressive = true)
+    {
+        Q_ASSERT(root);
+        runner->root        = root;
+        runner->hasRoot     = true;
+        runner->progressive = progressive;
+        if (!progressive)
+            root->setUpdatesEnabled(false);
+        return *this;
+    }
+
+    /// Called once all items have been added
+    IncrementalBuild& onFinished(std::function<void()> func)
+    {
+        runner->finished = std::move(func);
+        return *this;
+    }
+
+private:
+    impl::incremental::Runner* runner;
+    impl::builder::Scheduler*  outer;
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_INCREMENTAL_H
@@ -0,0 +1,276 @@
+/**
+ * @brief Load large files and documents into text editors without blocking the event loop
+ * @details
+ * The file is memory-mapped when possible and decoded incrementally, the text is appended in slices of at most the
+ * time budget while the event loop keeps running:
+ *      @code{.cpp}
+ *      auto bar = MetaObject<>::from(new QProgressBar);
+ *
+ *      QLayout* layout = VBoxLayout{
+ *          PlainTextEdit().readOnly(true).loadFile("huge.log",
+ *                                                  [bar](qint64 loaded, qint64 total) {
+ *                                                      bar.maximum() = 1000;
+ *                                                      bar.value()   = total ? loaded * 1000 / total : 1000;
+ *                                                  }),
+ *          bar,
+ *      };
+ *
+ *      // later, e.g. from a cancel button
+ *      if (auto loader = TextFileLoader::of(edit))
+ *          loader->cancel();
+ *      @endcode
+ *
+ * Notes:
+ *      - The encoding is taken from a byte order mark, UTF-8 otherwise.
+ *      - Undo and redo are disabled while loading, the document is cleared when the load starts.
+ *      - A cancelled load keeps the text loaded so far. Starting a new load on the same editor cancels the old one.
+ *      - The progress callback is called after each slice, and with loaded == total once the load has finished.
+ *
+ * Rich text is parsed into a QTextDocument on QThreadPool::globalInstance(), the editor shows a placeholder until the
+ * document is handed to it on the GUI thread:
+ *      @code{.cpp}
+ *      TextBrowser().htmlAsync(report, "Loading...");
+ *      @endcode
+ *
+ *      A later load on the same editor supersedes the running one, its document is discarded, or not parsed at all
+ *      if it has not started yet. Resources referenced by the document are resolved when it is shown.
+ */
+
+#ifndef NWIDGET_LOADERS_H
+#define NWIDGET_LOADERS_H
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringDecoder>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QThreadPool>
+#include <QWidget>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace nwidget {
+
+class TextFileLoader : public QObject
+{
+    Q_DISABLE_COPY_MOVE(TextFileLoader)
+
+public:
+    using Progress = std::function<void(qint64 loaded, qint64 total)>;
+
+    /// Replace the text of edit, e.g. QPlainTextEdit or QTextEdit, with the content of path
+    template <typename Edit>
+    static TextFileLoader* load(Edit*                     edit,
+                                const QString&            path,
+                                Progress                  progress = {},
+                                std::chrono::milliseconds budget   = std::chrono::milliseconds(8))
+    {
+        Q_ASSERT(edit);
+
+        if (const auto running = of(edit))
+            running->cancel();
+        return new TextFileLoader(edit, edit->document(), path, std::move(progress), budget);
+    }
+
+    /// The running load of edit, nullptr if there is none
+    static TextFileLoader* of(QWidget* edit)
+    {
+        return static_cast<TextFileLoader*>(
+            edit->findChild<QObject*>("nwidget::TextFileLoader", Qt::FindDirectChildrenOnly));
+    }
+
+    qint64 loaded() const { return offset; }
+    qint64 total() const { return size; }
+
+    /// Stop loading and keep the text loaded so far
+    void cancel() { finish(); }
+
+private:
+    static constexpr qint64 chunkSize = 64 * 1024;
+
+    QTextDocument*            document;
+    QFile                     file;
+    uchar*                    data   = nullptr;
+    qint64                    size   = 0;
+    qint64                    offset = 0;
+    QStringDecoder            decoder;
+    QString                   pending; // trailing '\r' of the previous chunk
+    Progress                  progress;
+    std::chrono::milliseconds budget;
+    bool                      undo;
+    bool                      done = false;
+
+    TextFileLoader(QWidget*                  edit,
+                   QTextDocument*            document,
+                   const QString&            path,
+                   Progress                  progress,
+                   std::chrono::milliseconds budget)
+        : QObject(edit)
+        , document(document)
+        , file(path)
+        , progress(std::move(progress))
+        , budget(budget)
+        , undo(document->isUndoRedoEnabled())
+    {
+        setObjectName("nwidget::TextFileLoader");
+
+        document->setUndoRedoEnabled(false);
+        document->clear();
+
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning("nwidget::TextFileLoader: cannot open %s", qPrintable(path));
+            finish();
+            return;
+        }
+
+        size = file.size();
+        data = file.map(0, size); // falls back to reading, e.g. for resources
+
+        char       head[4]  = {};
+        const auto n        = data ? qMin<qint64>(size, 4) : file.peek(head, 4);
+        const auto encoding = QStringConverter::encodingForData(QByteArrayView(data ? (const char*)data : head, n));
+        decoder             = QStringDecoder(encoding.value_or(QStringConverter::Utf8));
+
+        schedule();
+    }
+
+    void schedule()
+    {
+        QMetaObject::invokeMethod(this, [this] { slice(); }, Qt::QueuedConnection);
+    }
+
+    void slice()
+    {
+        if (done)
+            return;
+
+        QTextCursor cursor(document);
+        cursor.movePosition(QTextCursor::End);
+        cursor.beginEditBlock();
+
+        QElapsedTimer timer;
+        timer.start();
+        while (offset < size && timer.elapsed() < budget.count()) {
+            const auto n = qMin(chunkSize, size - offset);
+
+            QString text = pending;
+            if (data)
+                text += decoder.decode(QByteArrayView(reinterpret_cast<const char*>(data) + offset, n));
+            else
+                text += decoder.decode(file.read(n));
+            offset += n;
+
+            // keep a '\r' which may be followed by '\n' in the next chunk
+            pending.clear();
+            if (offset < size && text.endsWith(QLatin1Char('\r'))) {
+                pending = QStringLiteral("\r");
+                text.chop(1);
+            }
+            text.replace(QLatin1String("\r\n"), QLatin1String("\n"));
+            cursor.insertText(text);
+        }
+
+        if (offset >= size && !pending.isEmpty())
+            cursor.insertText(pending);
+        cursor.endEditBlock();
+
+        if (offset < size) {
+            if (progress)
+                progress(offset, size);
+            schedule();
+        } else
+            finish();
+    }
+
+    void finish()
+    {
+        if (done)
+            return;
+        done = true;
+
+        if (data)
+            file.unmap(data);
+        file.close();
+        document->setUndoRedoEnabled(undo);
+        setObjectName({}); // no longer found by of()
+
+        if (progress)
+            progress(offset >= size ? size : offset, size);
+        deleteLater();
+    }
+};
+
+/// Builds rich text documents on the worker pool and hands them to an editor, one per editor, see loaders.h
+class DocumentLoader : public QObject
+{
+    Q_DISABLE_COPY_MOVE(DocumentLoader)
+
+public:
+    enum Format { Html, Markdown };
+
+    /// Show placeholder in edit, e.g. QTextEdit or QTextBrowser, until text is parsed, superseding earlier loads
+    template <typename Edit>
+    static void load(Edit* edit, Format format, const QString& text, const QString& placeholder = {})
+    {
+        Q_ASSERT(edit);
+
+        auto loader = static_cast<DocumentLoader*>(
+            edit->findChild<QObject*>("nwidget::DocumentLoader", Qt::FindDirectChildrenOnly));
+        if (!loader)
+            loader = new DocumentLoader(edit);
+
+        const int  generation = ++*loader->generation;
+        const auto thread     = loader->thread();
+        edit->setPlainText(placeholder);
+
+        QThreadPool::globalInstance()->start(
+            [counter = loader->generation, generation, thread, edit, format, text]
+            {
+                if (*counter != generation)
+                    return; // superseded before it started
+
+                const auto document = new QTextDocument;
+                if (format == Html)
+                    document->setHtml(text);
+                else
+                    document->setMarkdown(text);
+                document->moveToThread(thread);
+
+                QMetaObject::invokeMethod(
+                    QCoreApplication::instance(),
+                    [counter, generation, edit, document]
+                    {
+                        // the loader sets the counter to -1 when it is destroyed together with the editor
+                        if (*counter != generation) {
+                            delete document;
+                            return;
+                        }
+
+                        // the editor resolves resources of its child document, and deletes the previous one
+                        document->setDefaultFont(edit->font());
+                        document->setParent(edit);
+                        edit->setDocument(document);
+                    },
+                    Qt::QueuedConnection);
+            });
+    }
+
+    ~DocumentLoader() override { *generation = -1; }
+
+private:
+    std::shared_ptr<std::atomic<int>> generation = std::make_shared<std::atomic<int>>(0);
+
+    explicit DocumentLoader(QWidget* edit)
+        : QObject(edit)
+    {
+        setObjectName("nwidget::DocumentLoader");
+    }
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_LOADERS_H
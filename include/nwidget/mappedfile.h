@@ -0,0 +1,41 @@
+#ifndef NWIDGET_MAPPEDFILE_H
+#define NWIDGET_MAPPEDFILE_H
+
+#include <QByteArray>
+#include <QFile>
+
+namespace nwidget::impl::mappedfile {
+
+/// Memory-mapped file, read into memory if it cannot be mapped
+class MappedFile
+{
+public:
+    explicit MappedFile(const QString& path)
+        : file(path)
+    {
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning("nwidget: cannot open %s", qPrintable(path));
+            return;
+        }
+        size_ = file.size();
+        data_ = reinterpret_cast<const char*>(file.map(0, size_));
+        if (!data_) {
+            buffer = file.readAll();
+            data_  = buffer.constData();
+            size_  = buffer.size();
+        }
+    }
+
+    const char* data() const { return data_; }
+    qint64      size() const { return size_; }
+
+private:
+    QFile       file; // unmapped when closed
+    QByteArray  buffer;
+    const char* data_ = nullptr;
+    qint64      size_ = 0;
+};
+
+} // namespace nwidget::impl::mappedfile
+
+#endif // NWIDGET_MAPPEDFILE_H
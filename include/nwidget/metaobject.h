@@ -52,7 +52,8 @@
 namespace nwidget {
 
 template <typename Action, typename... Args> class BindingExpr;
-;
+template <typename Expr, typename Anim> class Animated;
+template <typename T> class Pending;
 
 /* -------------------------------------------------- MetaProperty -------------------------------------------------- */
 
@@ -137,7 +137,7 @@ template <> class nwidget::MetaObject<QWidget> : public MetaObject<QObject>
     N_PROPERTY(int, maximumHeight, N_READ maximumHeight N_WRITE setMaximumHeight)
     N_PROPERTY(QSize, sizeIncrement, N_READ sizeIncrement N_WRITE setSizeIncrement)
     N_PROPERTY(QSize, baseSize, N_READ baseSize N_WRITE setBaseSize)
-    N_PROPERTY(QPalette, alette, N_READ palette N_WRITE setPalette)
+    N_PROPERTY(QPalette, palette, N_READ palette N_WRITE setPalette)
     N_PROPERTY(QFont, font, N_READ font N_WRITE setFont)
 #ifndef QT_NO_CURSOR
     N_PROPERTY(QCursor, cursor, N_READ cursor N_WRITE setCursor)
@@ -723,7 +723,7 @@ template <> class nwidget::MetaObject<QLabel> : public MetaObject<QWidget>
     N_PROPERTY(int, margin, N_READ margin N_WRITE setMargin)
     N_PROPERTY(int, indent, N_READ indent N_WRITE setIndent)
     N_PROPERTY(bool, openExternalLinks, N_READ openExternalLinks N_WRITE setOpenExternalLinks)
-    N_PROPERTY(Qt::TextInteractionFlags, InteractionFlags, N_READ textInteractionFlags N_WRITE setTextInteractionFlags)
+    N_PROPERTY(Qt::TextInteractionFlags, textInteractionFlags, N_READ textInteractionFlags N_WRITE setTextInteractionFlags)
     N_PROPERTY(bool, hasSelectedText, N_READ hasSelectedText)
     N_PROPERTY(QString, selectedText, N_READ selectedText)
 };
@@ -0,0 +1,540 @@
+/**
+ * @brief Item models over user containers, typed table columns and lazily fetched trees
+ * @details
+ * QComboBox::addItems and QListWidget copy every entry into an item object. A container model reads the entries of
+ * a container in place instead, through an optional projection:
+ *      @code{.cpp}
+ *      std::vector<City> cities = loadCities(); // 100k entries
+ *
+ *      QLayout* layout = VBoxLayout{
+ *          ComboBox().model(std::move(cities), [](const City& c) { return c.name; }), // the model owns cities
+ *          ListView().model(QStringList{"a", "b", "c"}),
+ *      };
+ *      @endcode
+ *
+ * Notes:
+ *      - An lvalue container is referenced and must outlive the model, an rvalue container is moved into the model.
+ *        Pass a view such as std::span to reference a part of an array.
+ *      - The container needs std::size and random access iterators.
+ *      - The projection is called with an entry and returns the display value, or with an entry and a role and
+ *        returns a QVariant for that role. Without a projection the entry itself is the display value.
+ *      - Call reset() after changing a referenced container.
+ *
+ * A table model describes the columns of a row type once, each column reads its value with a typed getter and
+ * the value is converted to a QVariant only in data():
+ *      @code{.cpp}
+ *      struct Trade { QString symbol; double price; int quantity; };
+ *      std::vector<Trade> trades = ...; // a million rows
+ *
+ *      TableView().model(std::move(trades), // the model owns trades
+ *                        TableColumn("Symbol", &Trade::symbol),
+ *                        EditableTableColumn("Price", &Trade::price),
+ *                        TableColumn("Value", [](const Trade& t) { return t.price * t.quantity; }));
+ *
+ *      // columnar storage, getters and setters are called with the row
+ *      std::vector<double>& prices = portfolio->prices; // referenced, outlives the model
+ *      TableView().model(Rows{int(prices.size())}, EditableTableColumn("Price", prices));
+ *
+ *      // a column set described once and shared by several views
+ *      const TableColumns tradeColumns(TableColumn("Symbol", &Trade::symbol), TableColumn("Price", &Trade::price));
+ *      TableView().model(std::move(buys), tradeColumns);
+ *      TableView().model(std::move(sells), tradeColumns);
+ *      @endcode
+ *
+ * A lazy tree model asks for the children of a node only when a view expands it:
+ *      @code{.cpp}
+ *      auto model = new LazyTreeModel<QString>(
+ *          "/",
+ *          [](const QString& dir) { return listDir(dir); },
+ *          [](const QString& path, int, int role) { return role == Qt::DisplayRole ? path : QVariant(); });
+ *      model->setHasChildren([](const QString& path) { return QFileInfo(path).isDir(); });
+ *
+ *      TreeView().model(model);
+ *      @endcode
+ *
+ *      Top level items are inserted in batches while the view scrolls, the children of a node when it is expanded.
+ */
+
+#ifndef NWIDGET_MODELS_H
+#define NWIDGET_MODELS_H
+
+#include <QAbstractListModel>
+#include <QAbstractTableModel>
+#include <QVariant>
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nwidget {
+
+namespace impl::models {
+
+template <typename Container> struct Ref
+{
+    Container* container;
+
+    Container& get() const { return *container; }
+};
+
+template <typename Container> struct Own
+{
+    Container container;
+
+    Container&       get() { return container; }
+    const Container& get() const { return container; }
+};
+
+template <typename Getter, typename Setter> struct ColumnSpec
+{
+    static constexpr bool editable = !std::is_same_v<Setter, std::nullptr_t>;
+
+    QString title;
+    Getter  get;
+    Setter  set;
+};
+
+template <typename Func, typename Element> decltype(auto) call(const Func& func, const Element& element, int row)
+{
+    if constexpr (std::is_invocable_v<const Func&, const Element&>)
+        return func(element);
+    else
+        return func(row);
+}
+
+struct Identity
+{
+    template <typename T> const T& operator()(const T& value) const { return value; }
+};
+
+template <typename T> QVariant variant(const T& value)
+{
+    if constexpr (std::is_constructible_v<QVariant, const T&>)
+        return QVariant(value);
+    else
+        return QVariant::fromValue(value);
+}
+
+template <typename Container>
+using Storage = std::conditional_t<std::is_lvalue_reference_v<Container>,
+                                   Ref<std::remove_reference_t<Container>>,
+                                   Own<std::remove_cv_t<std::remove_reference_t<Container>>>>;
+
+} // namespace impl::models
+
+template <typename Storage, typename Projection> class ContainerModel : public QAbstractListModel
+{
+public:
+    ContainerModel(Storage storage, Projection projection, QObject* parent = nullptr)
+        : QAbstractListModel(parent)
+        , storage(std::move(storage))
+        , projection(std::move(projection))
+    {
+        setObjectName("nwidget::ContainerModel");
+    }
+
+    const auto& container() const { return storage.get(); }
+
+    /// Notify the views after the referenced container has changed
+    void reset()
+    {
+        beginResetModel();
+        endResetModel();
+    }
+
+    int rowCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(std::size(container()));
+    }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+    {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+            return {};
+
+        const auto& entry = std::begin(container())[index.row()];
+        if constexpr (std::is_invocable_v<const Projection&, decltype(entry), int>)
+            return projection(entry, role);
+        else if (role == Qt::DisplayRole || role == Qt::EditRole)
+            return impl::models::variant(projection(entry));
+        else
+            return {};
+    }
+
+    Qt::ItemFlags flags(const QModelIndex& index) const override
+    {
+        return index.isValid() ? Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemNeverHasChildren : Qt::NoItemFlags;
+    }
+
+private:
+    Storage    storage;
+    Projection projection;
+};
+
+/// Create a model over container, see models.h
+template <typename Container, typename Projection = impl::models::Identity>
+auto makeContainerModel(Container&& container, Projection projection = {}, QObject* parent = nullptr)
+{
+    using Storage = impl::models::Storage<Container>;
+    if constexpr (std::is_lvalue_reference_v<Container>)
+        return new ContainerModel<Storage, Projection>(Storage{&container}, std::move(projection), parent);
+    else
+        return new ContainerModel<Storage, Projection>(Storage{std::move(container)}, std::move(projection), parent);
+}
+
+/// Row indices as a container, for table models over columnar storage
+struct Rows
+{
+    struct Iterator
+    {
+        int operator[](int row) const { return row; }
+    };
+
+    int count;
+
+    Iterator begin() const { return {}; }
+    int      size() const { return count; }
+};
+
+/// Read-only column of a TableModel, getter is a member pointer or called with a row, see models.h
+template <typename Getter> auto TableColumn(const QString& title, Getter getter)
+{
+    if constexpr (std::is_member_object_pointer_v<Getter>) {
+        const auto get = [getter](const auto& row) -> decltype(auto) { return row.*getter; };
+        return impl::models::ColumnSpec<decltype(get), std::nullptr_t>{title, get, nullptr};
+    } else
+        return impl::models::ColumnSpec<Getter, std::nullptr_t>{title, getter, nullptr};
+}
+
+/// Read-only column over a column of columnar storage, used with TableModel over Rows
+template <typename T> auto TableColumn(const QString& title, const std::vector<T>& column)
+{
+    return TableColumn(title, [&column](int row) -> const T& { return column[row]; });
+}
+
+/// The column is referenced, not copied, and must outlive the model
+template <typename T> auto TableColumn(const QString& title, const std::vector<T>&& column) = delete;
+
+/// Editable column, setter is called with the row and the new value
+template <typename Getter, typename Setter>
+auto EditableTableColumn(const QString& title, Getter getter, Setter setter)
+{
+    return impl::models::ColumnSpec<Getter, Setter>{title, getter, setter};
+}
+
+/// Editable column over a column of columnar storage, used with TableModel over Rows
+template <typename T> auto EditableTableColumn(const QString& title, std::vector<T>& column)
+{
+    return EditableTableColumn(
+        title,
+        [&column](int row) -> const T& { return column[row]; },
+        [&column](int row, const T& value) { column[row] = value; });
+}
+
+/// Editable column of a TableModel over a data member
+template <typename T, typename V> auto EditableTableColumn(const QString& title, V T::*member)
+{
+    return EditableTableColumn(
+        title,
+        [member](const T& row) -> const V& { return row.*member; },
+        [member](T& row, const V& value) { row.*member = value; });
+}
+
+/// Columns of a TableModel described once, to create several models with the same columns
+template <typename... Columns> class TableColumns
+{
+public:
+    explicit TableColumns(Columns... columns)
+        : columns(std::move(columns)...)
+    {
+    }
+
+    std::tuple<Columns...> columns;
+};
+
+/// Table model over a container of rows, one typed getter per column, see models.h
+template <typename Storage, typename... Columns> class TableModel : public QAbstractTableModel
+{
+public:
+    TableModel(Storage storage, std::tuple<Columns...> columns, QObject* parent = nullptr)
+        : QAbstractTableModel(parent)
+        , storage(std::move(storage))
+        , columns(std::move(columns))
+    {
+        setObjectName("nwidget::TableModel");
+    }
+
+    const auto& container() const { return storage.get(); }
+
+    /// Typed value of column C in row, without converting it to a QVariant
+    template <std::size_t C> decltype(auto) value(int row) const
+    {
+        return impl::models::call(std::get<C>(columns).get, std::begin(container())[row], row);
+    }
+
+    /// Notify the views after the referenced container has changed
+    void reset()
+    {
+        beginResetModel();
+        endResetModel();
+    }
+
+    int rowCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(std::size(container()));
+    }
+
+    int columnCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(sizeof...(Columns));
+    }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+    {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+            return {};
+
+        const auto  row     = index.row();
+        const auto& element = std::begin(container())[row];
+        return visit(index.column(),
+                     [&](const auto& column) -> QVariant
+                     {
+                         decltype(auto) v = impl::models::call(column.get, element, row);
+                         if (role == Qt::DisplayRole || role == Qt::EditRole)
+                             return impl::models::variant(v);
+                         if (role == Qt::TextAlignmentRole && std::is_arithmetic_v<std::decay_t<decltype(v)>>)
+                             return QVariant::fromValue(Qt::Alignment(Qt::AlignRight | Qt::AlignVCenter));
+                         return {};
+                     });
+    }
+
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override
+    {
+        if (role != Qt::EditRole || !checkIndex(index, CheckIndexOption::IndexIsValid))
+            return false;
+
+        const auto row     = index.row();
+        const auto changed = visit(index.column(),
+                                   [&](const auto& column) -> QVariant
+                                   {
+                                       using Column = std::decay_t<decltype(column)>;
+                                       if constexpr (Column::editable) {
+                                           // a row of Rows is its index, setters of columnar storage take the row
+                                           using Element = decltype(std::begin(storage.get())[row]);
+                                           decltype(auto) element = std::begin(storage.get())[row];
+                                           using V                = std::decay_t<decltype(impl::models::call(
+                                               column.get, std::as_const(element), row))>;
+                                           auto converted = value; // "abc" does not convert to a number
+                                           if (!converted.convert(QMetaType::fromType<V>()))
+                                               return false;
+                                           if constexpr (std::is_reference_v<Element>
+                                                         && std::is_invocable_v<const decltype(column.set)&, Element, V>)
+                                               column.set(element, qvariant_cast<V>(converted));
+                                           else
+                                               column.set(row, qvariant_cast<V>(converted));
+                                           return true;
+                                       } else
+                                           return false;
+                                   })
+                                 .toBool();
+
+        if (changed)
+            emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+        return changed;
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+    {
+        if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+            return visit(section, [](const auto& column) -> QVariant { return column.title; });
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    Qt::ItemFlags flags(const QModelIndex& index) const override
+    {
+        if (!index.isValid())
+            return Qt::NoItemFlags;
+        const auto editable = visit(index.column(),
+                                    [](const auto& column) -> QVariant
+                                    { return std::decay_t<decltype(column)>::editable; });
+        return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemNeverHasChildren
+             | (editable.toBool() ? Qt::ItemIsEditable : Qt::NoItemFlags);
+    }
+
+private:
+    Storage                storage;
+    std::tuple<Columns...> columns;
+
+    template <typename Func> QVariant visit(int column, Func func) const
+    {
+        QVariant result;
+        int      i = 0;
+        std::apply([&](const auto&... c) { (void)((i++ == column ? (result = func(c), true) : false) || ...); },
+                   columns);
+        return result;
+    }
+};
+
+/// Create a table model over container with the given columns, pass Rows{n} for columnar storage
+template <typename Container, typename... Columns>
+auto makeTableModel(Container&& container, Columns... columns)
+{
+    using Storage = impl::models::Storage<Container>;
+    if constexpr (std::is_lvalue_reference_v<Container>)
+        return new TableModel<Storage, Columns...>(Storage{&container}, {std::move(columns)...});
+    else
+        return new TableModel<Storage, Columns...>(Storage{std::move(container)}, {std::move(columns)...});
+}
+
+/// Create a table model over container with a column set described once
+template <typename Container, typename... Columns>
+auto makeTableModel(Container&& container, const TableColumns<Columns...>& columns)
+{
+    using Storage = impl::models::Storage<Container>;
+    if constexpr (std::is_lvalue_reference_v<Container>)
+        return new TableModel<Storage, Columns...>(Storage{&container}, columns.columns);
+    else
+        return new TableModel<Storage, Columns...>(Storage{std::move(container)}, columns.columns);
+}
+
+/// Tree model fetching the children of a node when a view expands it, see models.h
+template <typename Node> class LazyTreeModel : public QAbstractItemModel
+{
+public:
+    using Children    = std::function<std::vector<Node>(const Node& parent)>;
+    using Data        = std::function<QVariant(const Node& node, int column, int role)>;
+    using HasChildren = std::function<bool(const Node& node)>;
+
+    /// The children of root are the top level items
+    LazyTreeModel(Node root, Children children, Data data, int columns = 1, QObject* parent = nullptr)
+        : QAbstractItemModel(parent)
+        , children(std::move(children))
+        , nodeData(std::move(data))
+        , columns(columns)
+    {
+        setObjectName("nwidget::LazyTreeModel");
+        top.node = std::move(root);
+        fetchMore({});
+    }
+
+    /// Tell whether a node has children before fetching them, otherwise every node is expandable until fetched
+    void setHasChildren(HasChildren func) { hasChildrenFunc = std::move(func); }
+
+    /// Number of top level items inserted per fetch
+    void setBatchSize(int size) { batchSize = qMax(1, size); }
+
+    const Node& node(const QModelIndex& index) const { return entry(index)->node; }
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = {}) const override
+    {
+        const auto e = entry(parent);
+        if (row < 0 || row >= static_cast<int>(e->children.size()) || column < 0 || column >= columns)
+            return {};
+        return createIndex(row, column, e->children[row].get());
+    }
+
+    QModelIndex parent(const QModelIndex& child) const override
+    {
+        if (!child.isValid())
+            return {};
+        const auto p = entry(child)->parent;
+        return p == &top ? QModelIndex() : createIndex(p->row, 0, p);
+    }
+
+    int rowCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.column() > 0 ? 0 : static_cast<int>(entry(parent)->children.size());
+    }
+
+    int columnCount(const QModelIndex& = {}) const override { return columns; }
+
+    bool hasChildren(const QModelIndex& parent = {}) const override
+    {
+        if (parent.column() > 0)
+            return false;
+        const auto e = entry(parent);
+        if (!e->children.empty() || e->next < e->pending.size())
+            return true;
+        return !e->fetched && (!hasChildrenFunc || hasChildrenFunc(e->node));
+    }
+
+    bool canFetchMore(const QModelIndex& parent) const override
+    {
+        const auto e = entry(parent);
+        return (!e->fetched && (!hasChildrenFunc || hasChildrenFunc(e->node))) || e->next < e->pending.size();
+    }
+
+    void fetchMore(const QModelIndex& parent) override
+    {
+        const auto e = entry(parent);
+        if (!e->fetched) {
+            e->fetched = true;
+            if (!hasChildrenFunc || hasChildrenFunc(e->node))
+                e->pending = children(e->node);
+        }
+
+        // the view fetches more top level items while scrolling, children are inserted at once on expansion
+        const auto left  = e->pending.size() - e->next;
+        const auto count = e == &top ? qMin(left, static_cast<std::size_t>(batchSize)) : left;
+        if (count > 0) {
+            const auto first = static_cast<int>(e->children.size());
+            beginInsertRows(parent, first, first + static_cast<int>(count) - 1);
+            e->children.reserve(e->children.size() + count);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto child    = std::make_unique<Entry>();
+                child->node   = std::move(e->pending[e->next++]);
+                child->parent = e;
+                child->row    = first + static_cast<int>(i);
+                e->children.push_back(std::move(child));
+            }
+            endInsertRows();
+        }
+
+        if (e->next == e->pending.size()) {
+            e->pending = {};
+            e->next    = 0;
+        }
+    }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+    {
+        return index.isValid() ? nodeData(entry(index)->node, index.column(), role) : QVariant();
+    }
+
+    Qt::ItemFlags flags(const QModelIndex& index) const override
+    {
+        return index.isValid() ? Qt::ItemIsEnabled | Qt::ItemIsSelectable : Qt::NoItemFlags;
+    }
+
+private:
+    struct Entry
+    {
+        Node                                node;
+        Entry*                              parent  = nullptr;
+        int                                 row     = 0;
+        bool                                fetched = false;
+        std::vector<Node>                   pending; // fetched but not inserted yet
+        std::size_t                         next = 0;
+        std::vector<std::unique_ptr<Entry>> children;
+    };
+
+    Entry       top;
+    Children    children;
+    Data        nodeData;
+    HasChildren hasChildrenFunc;
+    int         columns;
+    int         batchSize = 256;
+
+    Entry* entry(const QModelIndex& index) const
+    {
+        return index.isValid() ? static_cast<Entry*>(index.internalPointer()) : const_cast<Entry*>(&top);
+    }
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_MODELS_H
@@ -0,0 +1,175 @@
+/**
+ * @brief All headers of nwidget with the Qt headers its builders support, and the prebuilt builder instantiations
+ * @details
+ * Include this header instead of the Qt headers and builders.h to get every builder. It depends on nothing but the
+ * compiler flags, which makes it suitable as a precompiled header:
+ *      @code{.cmake}
+ *      target_precompile_headers(app PRIVATE <nwidget/prebuilt.h>)
+ *      @endcode
+ *
+ * When linking the nwidget_prebuilt target, N_PREBUILT is defined and the builders of the Qt classes are declared
+ * extern template, they are instantiated once in the library instead of in every translation unit:
+ *      @code{.cmake}
+ *      set(NWIDGET_BUILD_PREBUILT ON)
+ *      target_link_libraries(app PRIVATE nwidget::nwidget_prebuilt)
+ *      @endcode
+ *
+ * Only the members which are not templates are prebuilt, e.g. properties taking a value and setters. Member
+ * templates, such as signals and properties taking a binding, are still instantiated where they are used.
+ * MetaObject specializations of Qt classes are not templates and have nothing to prebuild.
+ */
+
+#ifndef NWIDGET_PREBUILT_H
+#define NWIDGET_PREBUILT_H
+
+#include <QAbstractButton>
+#include <QAbstractItemView>
+#include <QAbstractScrollArea>
+#include <QAbstractSlider>
+#include <QAbstractSpinBox>
+#include <QAction>
+#include <QBoxLayout>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QCommandLinkButton>
+#include <QDateTimeEdit>
+#include <QDial>
+#include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QFrame>
+#include <QGridLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLayout>
+#include <QLineEdit>
+#include <QListView>
+#include <QListWidget>
+#include <QMenu>
+#include <QMenuBar>
+#include <QObject>
+#include <QPlainTextEdit>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QRadioButton>
+#include <QScrollBar>
+#include <QSlider>
+#include <QSpinBox>
+#include <QSplitter>
+#include <QStackedLayout>
+#include <QTabBar>
+#include <QTableView>
+#include <QTableWidget>
+#include <QTabWidget>
+#include <QTextBrowser>
+#include <QTextEdit>
+#include <QToolBox>
+#include <QToolButton>
+#include <QTreeView>
+#include <QTreeWidget>
+#include <QWidget>
+
+#include "behavior.h"
+#include "binding.h"
+#include "builders.h"
+
+// clang-format off
+
+/**
+ * Builders with a default constructible class: X(Class, Base) for each builder of the chain, bases first, then
+ * Y(Class) for the builder itself. Builders of abstract classes and classes without default constructor are only
+ * prebuilt as part of the chains of their derived classes.
+ */
+#define N_PREBUILT_BUILDERS(X, Y)                                                                                      \
+    X(QObject, void) X(QObject, QObject) Y(QObject)                                                                    \
+    X(QAction, void) X(QAction, QObject) X(QAction, QAction) Y(QAction)                                                \
+    X(QHBoxLayout, void) X(QHBoxLayout, QObject) X(QHBoxLayout, QLayout) X(QHBoxLayout, QBoxLayout)                    \
+    X(QHBoxLayout, QHBoxLayout) Y(QHBoxLayout)                                                                         \
+    X(QVBoxLayout, void) X(QVBoxLayout, QObject) X(QVBoxLayout, QLayout) X(QVBoxLayout, QBoxLayout)                    \
+    X(QVBoxLayout, QVBoxLayout) Y(QVBoxLayout)                                                                         \
+    X(QFormLayout, void) X(QFormLayout, QObject) X(QFormLayout, QLayout) X(QFormLayout, QFormLayout) Y(QFormLayout)    \
+    X(QGridLayout, void) X(QGridLayout, QObject) X(QGridLayout, QLayout) X(QGridLayout, QGridLayout) Y(QGridLayout)    \
+    X(QStackedLayout, void) X(QStackedLayout, QObject) X(QStackedLayout, QLayout) X(QStackedLayout, QStackedLayout)    \
+    Y(QStackedLayout)                                                                                                  \
+    X(QWidget, void) X(QWidget, QObject) X(QWidget, QWidget) Y(QWidget)                                                \
+    X(QCheckBox, void) X(QCheckBox, QObject) X(QCheckBox, QWidget) X(QCheckBox, QAbstractButton)                       \
+    X(QCheckBox, QCheckBox) Y(QCheckBox)                                                                               \
+    X(QDialogButtonBox, void) X(QDialogButtonBox, QObject) X(QDialogButtonBox, QWidget)                                \
+    X(QDialogButtonBox, QDialogButtonBox) Y(QDialogButtonBox)                                                          \
+    X(QPushButton, void) X(QPushButton, QObject) X(QPushButton, QWidget) X(QPushButton, QAbstractButton)               \
+    X(QPushButton, QPushButton) Y(QPushButton)                                                                         \
+    X(QCommandLinkButton, void) X(QCommandLinkButton, QObject) X(QCommandLinkButton, QWidget)                          \
+    X(QCommandLinkButton, QAbstractButton) X(QCommandLinkButton, QPushButton)                                          \
+    X(QCommandLinkButton, QCommandLinkButton) Y(QCommandLinkButton)                                                    \
+    X(QRadioButton, void) X(QRadioButton, QObject) X(QRadioButton, QWidget) X(QRadioButton, QAbstractButton)           \
+    X(QRadioButton, QRadioButton) Y(QRadioButton)                                                                      \
+    X(QToolButton, void) X(QToolButton, QObject) X(QToolButton, QWidget) X(QToolButton, QAbstractButton)               \
+    X(QToolButton, QToolButton) Y(QToolButton)                                                                         \
+    X(QFrame, void) X(QFrame, QObject) X(QFrame, QWidget) X(QFrame, QFrame) Y(QFrame)                                  \
+    X(QAbstractScrollArea, void) X(QAbstractScrollArea, QObject) X(QAbstractScrollArea, QWidget)                       \
+    X(QAbstractScrollArea, QFrame) X(QAbstractScrollArea, QAbstractScrollArea) Y(QAbstractScrollArea)                  \
+    X(QListView, void) X(QListView, QObject) X(QListView, QWidget) X(QListView, QFrame)                                \
+    X(QListView, QAbstractScrollArea) X(QListView, QAbstractItemView) X(QListView, QListView) Y(QListView)             \
+    X(QListWidget, void) X(QListWidget, QObject) X(QListWidget, QWidget) X(QListWidget, QFrame)                        \
+    X(QListWidget, QAbstractScrollArea) X(QListWidget, QAbstractItemView) X(QListWidget, QListView)                    \
+    X(QListWidget, QListWidget) Y(QListWidget)                                                                         \
+    X(QTableView, void) X(QTableView, QObject) X(QTableView, QWidget) X(QTableView, QFrame)                            \
+    X(QTableView, QAbstractScrollArea) X(QTableView, QAbstractItemView) X(QTableView, QTableView) Y(QTableView)        \
+    X(QTableWidget, void) X(QTableWidget, QObject) X(QTableWidget, QWidget) X(QTableWidget, QFrame)                    \
+    X(QTableWidget, QAbstractScrollArea) X(QTableWidget, QAbstractItemView) X(QTableWidget, QTableWidget)              \
+    Y(QTableWidget)                                                                                                    \
+    X(QTreeView, void) X(QTreeView, QObject) X(QTreeView, QWidget) X(QTreeView, QFrame)                                \
+    X(QTreeView, QAbstractScrollArea) X(QTreeView, QAbstractItemView) X(QTreeView, QTreeView) Y(QTreeView)             \
+    X(QTreeWidget, void) X(QTreeWidget, QObject) X(QTreeWidget, QWidget) X(QTreeWidget, QFrame)                        \
+    X(QTreeWidget, QAbstractScrollArea) X(QTreeWidget, QAbstractItemView) X(QTreeWidget, QTreeWidget) Y(QTreeWidget)   \
+    X(QPlainTextEdit, void) X(QPlainTextEdit, QObject) X(QPlainTextEdit, QWidget) X(QPlainTextEdit, QFrame)            \
+    X(QPlainTextEdit, QAbstractScrollArea) X(QPlainTextEdit, QPlainTextEdit) Y(QPlainTextEdit)                         \
+    X(QTextEdit, void) X(QTextEdit, QObject) X(QTextEdit, QWidget) X(QTextEdit, QFrame)                                \
+    X(QTextEdit, QAbstractScrollArea) X(QTextEdit, QTextEdit) Y(QTextEdit)                                             \
+    X(QTextBrowser, void) X(QTextBrowser, QObject) X(QTextBrowser, QWidget) X(QTextBrowser, QFrame)                    \
+    X(QTextBrowser, QAbstractScrollArea) X(QTextBrowser, QTextEdit) X(QTextBrowser, QTextBrowser) Y(QTextBrowser)      \
+    X(QToolBox, void) X(QToolBox, QObject) X(QToolBox, QWidget) X(QToolBox, QFrame) X(QToolBox, QToolBox)              \
+    Y(QToolBox)                                                                                                        \
+    X(QSplitter, void) X(QSplitter, QObject) X(QSplitter, QWidget) X(QSplitter, QFrame) X(QSplitter, QSplitter)        \
+    Y(QSplitter)                                                                                                       \
+    X(QAbstractSlider, void) X(QAbstractSlider, QObject) X(QAbstractSlider, QWidget)                                   \
+    X(QAbstractSlider, QAbstractSlider) Y(QAbstractSlider)                                                             \
+    X(QDial, void) X(QDial, QObject) X(QDial, QWidget) X(QDial, QAbstractSlider) X(QDial, QDial) Y(QDial)              \
+    X(QSlider, void) X(QSlider, QObject) X(QSlider, QWidget) X(QSlider, QAbstractSlider) X(QSlider, QSlider)           \
+    Y(QSlider)                                                                                                         \
+    X(QScrollBar, void) X(QScrollBar, QObject) X(QScrollBar, QWidget) X(QScrollBar, QAbstractSlider)                   \
+    X(QScrollBar, QScrollBar) Y(QScrollBar)                                                                            \
+    X(QAbstractSpinBox, void) X(QAbstractSpinBox, QObject) X(QAbstractSpinBox, QWidget)                                \
+    X(QAbstractSpinBox, QAbstractSpinBox) Y(QAbstractSpinBox)                                                          \
+    X(QDateTimeEdit, void) X(QDateTimeEdit, QObject) X(QDateTimeEdit, QWidget) X(QDateTimeEdit, QAbstractSpinBox)      \
+    X(QDateTimeEdit, QDateTimeEdit) Y(QDateTimeEdit)                                                                   \
+    X(QDateEdit, void) X(QDateEdit, QObject) X(QDateEdit, QWidget) X(QDateEdit, QAbstractSpinBox)                      \
+    X(QDateEdit, QDateTimeEdit) X(QDateEdit, QDateEdit) Y(QDateEdit)                                                   \
+    X(QTimeEdit, void) X(QTimeEdit, QObject) X(QTimeEdit, QWidget) X(QTimeEdit, QAbstractSpinBox)                      \
+    X(QTimeEdit, QDateTimeEdit) X(QTimeEdit, QTimeEdit) Y(QTimeEdit)                                                   \
+    X(QSpinBox, void) X(QSpinBox, QObject) X(QSpinBox, QWidget) X(QSpinBox, QAbstractSpinBox) X(QSpinBox, QSpinBox)    \
+    Y(QSpinBox)                                                                                                        \
+    X(QDoubleSpinBox, void) X(QDoubleSpinBox, QObject) X(QDoubleSpinBox, QWidget)                                      \
+    X(QDoubleSpinBox, QAbstractSpinBox) X(QDoubleSpinBox, QDoubleSpinBox) Y(QDoubleSpinBox)                            \
+    X(QComboBox, void) X(QComboBox, QObject) X(QComboBox, QWidget) X(QComboBox, QComboBox) Y(QComboBox)                \
+    X(QGroupBox, void) X(QGroupBox, QObject) X(QGroupBox, QWidget) X(QGroupBox, QGroupBox) Y(QGroupBox)                \
+    X(QLabel, void) X(QLabel, QObject) X(QLabel, QWidget) X(QLabel, QLabel) Y(QLabel)                                  \
+    X(QLineEdit, void) X(QLineEdit, QObject) X(QLineEdit, QWidget) X(QLineEdit, QLineEdit) Y(QLineEdit)                \
+    X(QMenu, void) X(QMenu, QObject) X(QMenu, QWidget) X(QMenu, QMenu) Y(QMenu)                                        \
+    X(QMenuBar, void) X(QMenuBar, QObject) X(QMenuBar, QWidget) X(QMenuBar, QMenuBar) Y(QMenuBar)                      \
+    X(QProgressBar, void) X(QProgressBar, QObject) X(QProgressBar, QWidget) X(QProgressBar, QProgressBar)              \
+    Y(QProgressBar)                                                                                                    \
+    X(QTabBar, void) X(QTabBar, QObject) X(QTabBar, QWidget) X(QTabBar, QTabBar) Y(QTabBar)                            \
+    X(QTabWidget, void) X(QTabWidget, QObject) X(QTabWidget, QWidget) X(QTabWidget, QTabWidget) Y(QTabWidget)
+
+// clang-format on
+
+#if defined(N_PREBUILT) && !defined(N_PREBUILT_INSTANTIATE)
+#define N_IMPL_PREBUILT_EXTERN_X(CLASS, BASE) extern template class nwidget::Builder<BASE, nwidget::Builder<CLASS>>;
+#define N_IMPL_PREBUILT_EXTERN_Y(CLASS)       extern template class nwidget::Builder<CLASS>;
+N_PREBUILT_BUILDERS(N_IMPL_PREBUILT_EXTERN_X, N_IMPL_PREBUILT_EXTERN_Y)
+#undef N_IMPL_PREBUILT_EXTERN_X
+#undef N_IMPL_PREBUILT_EXTERN_Y
+#endif
+
+#endif // NWIDGET_PREBUILT_H
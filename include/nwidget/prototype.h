@@ -0,0 +1,348 @@
+/**
+ * @brief Stamp out copies of a built widget tree without running the builder code again
+ * @details
+ * Capture a built tree once, then instantiate it as often as needed:
+ *      @code{.cpp}
+ *      const Prototype tile(
+ *          Widget(VBoxLayout{
+ *              Label("CPU").objectName("title"),
+ *              ProgressBar().objectName("load").range(0, 100),
+ *          }),
+ *          // binding template, applied to each instance
+ *          [source](QWidget* tile) {
+ *              MetaObject<>::from(tile->findChild<QProgressBar*>("load")).value() = source.value();
+ *          });
+ *
+ *      for (int i = 0; i < 500; ++i)
+ *          grid->addWidget(tile.instantiate(), i / 20, i % 20);
+ *      @endcode
+ *
+ * Captured:
+ *      - The class of every widget and layout reached through the layouts.
+ *      - Writable, stored and dynamic properties which differ from a default constructed object, as values.
+ *        Expressions that produced them are not evaluated again.
+ *      - The layout structure: box stretch and alignment, grid cells, form rows, spacers and layout margins.
+ *
+ * Not captured:
+ *      - Bindings and signal connections, set them up in the binding template.
+ *      - Content that is not managed by a layout, e.g. pages of QTabWidget or QStackedWidget, the widget of a
+ *        QScrollArea, items of item views and combo boxes.
+ *
+ * Instances are created with the default constructor of their class. Classes created by builders, QWidget, QLabel
+ * and the standard layouts are known automatically, others are registered with Prototype::registerClass<T>() or
+ * have a Q_INVOKABLE default constructor. Objects of unknown classes are skipped with a warning, an instance of an
+ * unknown root class is nullptr.
+ */
+
+#ifndef NWIDGET_PROTOTYPE_H
+#define NWIDGET_PROTOTYPE_H
+
+// the Qt headers come first, builders.h only declares the builders of classes already included
+#include <QBoxLayout>
+#include <QFormLayout>
+#include <QGridLayout>
+#include <QLabel>
+#include <QMetaProperty>
+#include <QWidget>
+
+#include "builders.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace nwidget {
+
+namespace impl::prototype {
+
+struct Node
+{
+    enum Kind { Spacer, Widget, Layout };
+
+    Kind                                            kind    = Widget;
+    const QMetaObject*                              meta    = nullptr;
+    impl::builders::Factory                         factory = nullptr; // nullptr for a Q_INVOKABLE constructor
+    std::vector<std::pair<QMetaProperty, QVariant>> properties;
+    std::vector<std::pair<QByteArray, QVariant>>    dynamicProperties;
+    bool                                            hidden = false;
+    QMargins                                        margins;  // layout
+    std::vector<Node>                               children; // widget: its layout, layout: its items
+
+    // position in the parent layout
+    int           stretch = 0;
+    Qt::Alignment align;
+    int           row = 0, col = 0, rowSpan = 1, colSpan = 1; // grid: cell, form: row and role in col
+    QSize         spacerSize;
+    QSizePolicy   spacerPolicy;
+};
+
+/// Classes which are not created by builders but implicitly, e.g. the labels of QFormLayout::addRow(QString, ...)
+inline void registerImplicitClasses()
+{
+    static const bool registered = []
+    {
+        auto& f = impl::builders::factories();
+        f.emplace(&QWidget::staticMetaObject, [] { return static_cast<QObject*>(new QWidget); });
+        f.emplace(&QLabel::staticMetaObject, [] { return static_cast<QObject*>(new QLabel); });
+        f.emplace(&QHBoxLayout::staticMetaObject, [] { return static_cast<QObject*>(new QHBoxLayout); });
+        f.emplace(&QVBoxLayout::staticMetaObject, [] { return static_cast<QObject*>(new QVBoxLayout); });
+        f.emplace(&QGridLayout::staticMetaObject, [] { return static_cast<QObject*>(new QGridLayout); });
+        f.emplace(&QFormLayout::staticMetaObject, [] { return static_cast<QObject*>(new QFormLayout); });
+        return true;
+    }();
+    Q_UNUSED(registered)
+}
+
+/// Find how to create instances of the class of o, false if it is unknown
+inline bool resolve(const QObject* o, Node& node)
+{
+    registerImplicitClasses();
+
+    node.meta    = o->metaObject();
+    const auto f = impl::builders::factories().find(node.meta);
+    node.factory = f != impl::builders::factories().end() ? f->second : nullptr;
+    if (node.factory)
+        return true;
+
+    for (int i = 0; i < node.meta->constructorCount(); ++i)
+        if (node.meta->constructor(i).parameterCount() == 0)
+            return true;
+
+    qWarning("nwidget::Prototype: %s is unknown and skipped, register it with Prototype::registerClass",
+             node.meta->className());
+    return false;
+}
+
+inline QObject* create(const Node& node)
+{
+    return node.factory ? node.factory() : node.meta->newInstance();
+}
+
+/// Default constructed objects to compare the captured properties with
+using Defaults = std::unordered_map<const QMetaObject*, std::unique_ptr<QObject>>;
+
+inline void properties(const QObject* o, Node& node, Defaults& defaults)
+{
+    const auto meta  = node.meta;
+    auto&      empty = defaults[meta];
+    if (!empty)
+        empty.reset(create(node));
+
+    for (int i = 0; i < meta->propertyCount(); ++i) {
+        const auto p = meta->property(i);
+        if (!p.isWritable() || !p.isStored())
+            continue;
+        // visibility is captured with isHidden(), geometry is owned by the parent layout
+        if (qstrcmp(p.name(), "visible") == 0 || qstrcmp(p.name(), "geometry") == 0)
+            continue;
+        auto value = p.read(o);
+        if (!(value == p.read(empty.get())))
+            node.properties.emplace_back(p, std::move(value));
+    }
+
+    for (const auto& name : o->dynamicPropertyNames())
+        if (!name.startsWith("_q_"))
+            node.dynamicProperties.emplace_back(name, o->property(name));
+}
+
+inline bool capture(const QLayout* layout, Defaults& defaults, Node& node);
+
+/// Capture widget into node, false if its class is unknown
+inline bool capture(const QWidget* widget, Defaults& defaults, Node& node)
+{
+    if (!resolve(widget, node))
+        return false;
+
+    node.kind   = Node::Widget;
+    node.hidden = widget->isHidden() && widget->testAttribute(Qt::WA_WState_ExplicitShowHide);
+    properties(widget, node, defaults);
+
+    Node layout;
+    if (widget->layout() && capture(widget->layout(), defaults, layout))
+        node.children.push_back(std::move(layout));
+    return true;
+}
+
+/// Capture layout into node, false if its class is unknown
+inline bool capture(const QLayout* layout, Defaults& defaults, Node& node)
+{
+    if (!resolve(layout, node))
+        return false;
+
+    node.kind    = Node::Layout;
+    node.margins = layout->contentsMargins();
+    properties(layout, node, defaults);
+
+    for (int i = 0; i < layout->count(); ++i) {
+        const auto item = layout->itemAt(i);
+
+        Node child;
+        if (item->widget()) {
+            if (!capture(item->widget(), defaults, child))
+                continue;
+        } else if (item->layout()) {
+            if (!capture(item->layout(), defaults, child))
+                continue;
+        } else if (const auto spacer = item->spacerItem()) {
+            child.kind         = Node::Spacer;
+            child.spacerSize   = spacer->sizeHint();
+            child.spacerPolicy = spacer->sizePolicy();
+        } else
+            continue;
+
+        child.align = item->alignment();
+        if (const auto box = qobject_cast<const QBoxLayout*>(layout))
+            child.stretch = box->stretch(i);
+        else if (const auto grid = qobject_cast<const QGridLayout*>(layout))
+            grid->getItemPosition(i, &child.row, &child.col, &child.rowSpan, &child.colSpan);
+        else if (const auto form = qobject_cast<const QFormLayout*>(layout)) {
+            QFormLayout::ItemRole role;
+            form->getItemPosition(i, &child.row, &role);
+            child.col = role;
+        }
+
+        node.children.push_back(std::move(child));
+    }
+
+    return true;
+}
+
+inline void apply(QObject* o, const Node& node)
+{
+    for (const auto& [p, value] : node.properties)
+        p.write(o, value);
+    for (const auto& [name, value] : node.dynamicProperties)
+        o->setProperty(name, value);
+}
+
+inline QLayout* createLayout(const Node& node);
+
+inline QWidget* createWidget(const Node& node)
+{
+    const auto w = static_cast<QWidget*>(create(node));
+    apply(w, node);
+    if (node.hidden)
+        w->hide();
+    if (!node.children.empty())
+        w->setLayout(createLayout(node.children.front()));
+    return w;
+}
+
+inline QLayout* createLayout(const Node& node)
+{
+    const auto l = static_cast<QLayout*>(create(node));
+    apply(l, node);
+    l->setContentsMargins(node.margins);
+
+    const auto box  = qobject_cast<QBoxLayout*>(l);
+    const auto grid = qobject_cast<QGridLayout*>(l);
+    const auto form = qobject_cast<QFormLayout*>(l);
+
+    // items of a form are not stored in row order, create the rows first
+    if (form)
+        for (const auto& c : node.children)
+            while (form->rowCount() <= c.row)
+                form->addRow(static_cast<QWidget*>(nullptr), static_cast<QWidget*>(nullptr));
+
+    for (const auto& c : node.children) {
+        QWidget*     widget = nullptr;
+        QLayout*     layout = nullptr;
+        QLayoutItem* item   = nullptr;
+
+        switch (c.kind) {
+        case Node::Widget:
+            widget = createWidget(c);
+            break;
+        case Node::Layout:
+            layout = createLayout(c);
+            break;
+        case Node::Spacer:
+            item = new QSpacerItem(c.spacerSize.width(),
+                                   c.spacerSize.height(),
+                                   c.spacerPolicy.horizontalPolicy(),
+                                   c.spacerPolicy.verticalPolicy());
+            break;
+        }
+
+        if (box) {
+            if (widget)
+                box->addWidget(widget, c.stretch, c.align);
+            else if (layout) {
+                box->addLayout(layout, c.stretch);
+                layout->setAlignment(c.align);
+            } else {
+                box->addItem(item);
+                box->setStretch(box->count() - 1, c.stretch);
+            }
+        } else if (grid) {
+            if (widget)
+                grid->addWidget(widget, c.row, c.col, c.rowSpan, c.colSpan, c.align);
+            else if (layout)
+                grid->addLayout(layout, c.row, c.col, c.rowSpan, c.colSpan, c.align);
+            else
+                grid->addItem(item, c.row, c.col, c.rowSpan, c.colSpan, c.align);
+        } else if (form) {
+            const auto role = static_cast<QFormLayout::ItemRole>(c.col);
+            if (widget)
+                form->setWidget(c.row, role, widget);
+            else if (layout)
+                form->setLayout(c.row, role, layout);
+            else
+                form->setItem(c.row, role, item);
+        } else {
+            if (widget)
+                l->addWidget(widget);
+            else
+                l->addItem(layout ? layout : item);
+        }
+    }
+
+    return l;
+}
+
+} // namespace impl::prototype
+
+class Prototype
+{
+public:
+    using Bindings = std::function<void(QWidget* instance)>;
+
+    /// Capture root and the widgets of its layouts, root is left untouched
+    explicit Prototype(QWidget* root, Bindings bindings = {})
+        : bindings(std::move(bindings))
+    {
+        impl::prototype::Defaults defaults;
+        impl::prototype::Node     captured;
+        if (impl::prototype::capture(root, defaults, captured))
+            node = std::make_shared<impl::prototype::Node>(std::move(captured));
+    }
+
+    /// Create a copy of the captured tree and apply the binding template to it, nullptr if the root was skipped
+    QWidget* instantiate(QWidget* parent = nullptr) const
+    {
+        if (!node)
+            return nullptr;
+
+        const auto w = impl::prototype::createWidget(*node);
+        if (parent)
+            w->setParent(parent);
+        if (bindings)
+            bindings(w);
+        return w;
+    }
+
+    /// Make a class not created by builders known to prototypes
+    template <typename Class> static void registerClass()
+    {
+        static_assert(std::is_base_of_v<QObject, Class>);
+        impl::builders::factories()[&Class::staticMetaObject] = [] { return static_cast<QObject*>(new Class); };
+    }
+
+private:
+    std::shared_ptr<const impl::prototype::Node> node;
+    Bindings                                     bindings;
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_PROTOTYPE_H
@@ -0,0 +1,902 @@
+/**
+ * @brief Proxy models sorting and filtering large flat models
+ * @details
+ * A SortProxyModel reads the sort column of the source model once into typed keys, sorts a permutation of the rows
+ * on QThreadPool::globalInstance() and applies it with a single layout change. The view keeps showing the old order
+ * until then:
+ *      @code{.cpp}
+ *      QLayout* layout = VBoxLayout{
+ *          TableView().csvFile("trades.csv").parallelSorting(), // click a header to sort
+ *      };
+ *
+ *      auto proxy = new SortProxyModel;
+ *      proxy->setSourceModel(model);
+ *      proxy->sort(2, Qt::DescendingOrder);
+ *      @endcode
+ *
+ * Notes:
+ *      - Numbers, booleans, dates and times are compared as numbers, other values as strings. The type is taken from
+ *        the first valid value of the column, invalid values sort first.
+ *      - Equal keys keep the order of the source rows.
+ *      - Models with fewer than 10000 rows are sorted on the GUI thread at once.
+ *      - A sort requested while another one is running supersedes it. Rows appended to the source model are
+ *        appended to an unsorted proxy, and merged into a sorted one with the keys of the new rows only. Other rows
+ *        inserted, removed or moved in the source model reset the proxy, which is then sorted again. Changed values
+ *        are shown, but not re-sorted.
+ *
+ * A FilterProxyModel keeps the case-folded text of the filter columns in one buffer per column, which is searched for
+ * the filter text with SSE2. When the filter text is extended, only the rows of the previous result are searched:
+ *      @code{.cpp}
+ *      auto search = new QLineEdit;
+ *
+ *      QLayout* layout = VBoxLayout{
+ *          search,
+ *          TableView().csvFile("trades.csv").filterBy(search, {0, 2}).parallelSorting(),
+ *      };
+ *      @endcode
+ *
+ *      A row is shown if one of its filter columns contains the filter text, all columns are filter columns unless
+ *      set otherwise. The text is indexed when a filter is first set, and again after changes of the source model
+ *      other than appended rows and changed values. Changed values are updated in the index, and the changed rows
+ *      are shown or hidden individually. A change of the filter text resets the proxy.
+ *
+ * Only flat models are supported, e.g. lists and tables.
+ */
+
+#ifndef NWIDGET_PROXIES_H
+#define NWIDGET_PROXIES_H
+
+#include <QAbstractProxyModel>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QThreadPool>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define N_IMPL_PROXIES_SSE2
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace nwidget {
+
+namespace impl::proxies {
+
+/// Call func(0) ... func(n - 1) on the worker pool and the calling thread, return when all calls have returned
+inline void parallelFor(int n, std::function<void(int)> func)
+{
+    struct State
+    {
+        std::function<void(int)> func;
+        int                      count;
+        std::atomic<int>         next{0};
+        int                      done = 0;
+        std::mutex               mutex;
+        std::condition_variable  finished;
+
+        // helpers which start late find nothing left to do, the caller never waits for a call not yet claimed
+        void run()
+        {
+            for (int i; (i = next++) < count;) {
+                func(i);
+                std::lock_guard lock(mutex);
+                if (++done == count)
+                    finished.notify_all();
+            }
+        }
+    };
+
+    const auto state = std::make_shared<State>();
+    state->func      = std::move(func);
+    state->count     = n;
+
+    const auto helpers = std::min(n, QThreadPool::globalInstance()->maxThreadCount()) - 1;
+    for (int i = 0; i < helpers; ++i)
+        QThreadPool::globalInstance()->start([state] { state->run(); });
+    state->run();
+
+    std::unique_lock lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->done == state->count; });
+}
+
+struct Keys
+{
+    int                  type    = QMetaType::UnknownType; // of the first valid value
+    bool                 numeric = true;
+    std::vector<double>  numbers;
+    std::vector<QString> strings;
+    Qt::CaseSensitivity  caseSensitivity = Qt::CaseSensitive;
+
+    int size() const { return static_cast<int>(numeric ? numbers.size() : strings.size()); }
+
+    bool less(int a, int b) const
+    {
+        if (numeric) {
+            const auto x = numbers[a];
+            const auto y = numbers[b];
+            if (std::isnan(x) || std::isnan(y))
+                return std::isnan(x) && !std::isnan(y);
+            return x < y;
+        }
+        return QString::compare(strings[a], strings[b], caseSensitivity) < 0;
+    }
+
+    /// Whether row a is sorted before row b, equal keys keep the order of the rows
+    bool before(int a, int b, Qt::SortOrder direction) const
+    {
+        if (less(a, b))
+            return direction == Qt::AscendingOrder;
+        if (less(b, a))
+            return direction == Qt::DescendingOrder;
+        return a < b;
+    }
+
+    /// Sort order of the rows, equal keys keep the order of the rows
+    void sort(std::vector<int>& order, Qt::SortOrder direction, bool parallel) const
+    {
+        const auto compare = [this, direction](int a, int b) { return before(a, b, direction); };
+
+        const auto n       = static_cast<int>(order.size());
+        const auto threads = QThreadPool::globalInstance()->maxThreadCount();
+        const auto chunks  = parallel ? std::clamp(n / 16384, 1, 4 * threads) : 1;
+
+        std::vector<int> bounds(chunks + 1);
+        for (int i = 0; i <= chunks; ++i)
+            bounds[i] = static_cast<int>(qint64(n) * i / chunks);
+
+        const auto begin = order.begin();
+        if (chunks == 1) {
+            std::sort(begin, order.end(), compare);
+            return;
+        }
+        parallelFor(chunks, [&](int i) { std::sort(begin + bounds[i], begin + bounds[i + 1], compare); });
+
+        for (int width = 1; width < chunks; width *= 2) {
+            parallelFor((chunks + 2 * width - 1) / (2 * width),
+                        [&](int pair)
+                        {
+                            const auto first = pair * 2 * width;
+                            if (first + width >= chunks)
+                                return;
+                            std::inplace_merge(begin + bounds[first],
+                                               begin + bounds[first + width],
+                                               begin + bounds[std::min(first + 2 * width, chunks)],
+                                               compare);
+                        });
+        }
+    }
+};
+
+/// First occurrence of needle in [begin, end), end if there is none
+inline const char* search(const char* begin, const char* end, const QByteArray& needle)
+{
+    const auto n = needle.size();
+    if (n == 0)
+        return begin;
+    if (end - begin < n)
+        return end;
+
+    const auto last = end - n; // last possible start
+#ifdef N_IMPL_PROXIES_SSE2
+    // compare 16 candidate starts at once with the first and the last byte, then the candidates in full
+    const auto head = _mm_set1_epi8(needle.front());
+    const auto tail = _mm_set1_epi8(needle.back());
+    for (; last - begin >= 15; begin += 16) {
+        const auto a    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const auto b    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + n - 1));
+        auto       mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, head), _mm_cmpeq_epi8(b, tail)));
+        for (; mask; mask &= mask - 1) {
+            int i = 0;
+            while (!(mask & (1 << i)))
+                ++i;
+            if (std::memcmp(begin + i, needle.constData(), n) == 0)
+                return begin + i;
+        }
+    }
+#endif
+    for (; begin <= last; ++begin)
+        if (*begin == needle.front() && std::memcmp(begin, needle.constData(), n) == 0)
+            return begin;
+    return end;
+}
+
+/// Case-folded UTF-8 text of a column, row i spans [starts[i], starts[i + 1] - 1) followed by a NUL byte
+struct TextColumn
+{
+    int                                 column;
+    QByteArray                          text;
+    std::vector<qint64>                 starts{0};
+    std::unordered_map<int, QByteArray> changed; // values of rows changed since, searched instead of text
+
+    void append(const QString& value)
+    {
+        text += value.toCaseFolded().toUtf8();
+        text += '\0';
+        starts.push_back(text.size());
+    }
+
+    /// Replace the value of row, the text is rewritten once many rows have changed
+    void set(int row, const QString& value)
+    {
+        changed[row] = value.toCaseFolded().toUtf8();
+        if (changed.size() > 1024 && changed.size() > starts.size() / 16)
+            compact();
+    }
+
+    bool contains(int row, const QByteArray& needle) const
+    {
+        if (const auto it = changed.find(row); it != changed.end())
+            return it->second.contains(needle);
+        const auto end = text.constData() + starts[row + 1] - 1;
+        return search(text.constData() + starts[row], end, needle) != end;
+    }
+
+    /// Mark the rows containing needle
+    void scan(const QByteArray& needle, std::vector<char>& hits) const
+    {
+        const auto begin = text.constData();
+        const auto end   = begin + text.size();
+        for (auto p = search(begin, end, needle); p != end; p = search(p, end, needle)) {
+            const auto next = std::upper_bound(starts.begin(), starts.end(), p - begin);
+            const auto row  = static_cast<int>(next - starts.begin() - 1);
+            if (changed.empty() || !changed.count(row))
+                hits[row] = true;
+            p = begin + *next; // the next row
+        }
+        for (const auto& [row, value] : changed)
+            if (value.contains(needle))
+                hits[row] = true;
+    }
+
+    void compact()
+    {
+        QByteArray          compacted;
+        std::vector<qint64> offsets{0};
+        compacted.reserve(text.size());
+        offsets.reserve(starts.size());
+        for (int row = 0; row + 1 < static_cast<int>(starts.size()); ++row) {
+            if (const auto it = changed.find(row); it != changed.end())
+                compacted += it->second;
+            else
+                compacted.append(text.constData() + starts[row], starts[row + 1] - 1 - starts[row]);
+            compacted += '\0';
+            offsets.push_back(compacted.size());
+        }
+        text   = std::move(compacted);
+        starts = std::move(offsets);
+        changed.clear();
+    }
+};
+
+} // namespace impl::proxies
+
+/// Proxy sorting a flat source model on the worker pool, see proxies.h
+class SortProxyModel : public QAbstractProxyModel
+{
+public:
+    explicit SortProxyModel(QObject* parent = nullptr)
+        : QAbstractProxyModel(parent)
+    {
+        setObjectName("nwidget::SortProxyModel");
+    }
+
+    ~SortProxyModel() override { *generation = -1; }
+
+    void setSourceModel(QAbstractItemModel* model) override
+    {
+        if (sourceModel())
+            disconnect(sourceModel(), nullptr, this, nullptr);
+
+        beginResetModel();
+        QAbstractProxyModel::setSourceModel(model);
+        identity();
+        endResetModel();
+
+        if (!model)
+            return;
+
+        const auto resort = [this]
+        {
+            beginResetModel();
+            identity();
+            endResetModel();
+            if (column >= 0)
+                sort(column, direction);
+        };
+        connect(model, &QAbstractItemModel::modelReset, this, resort);
+        connect(model,
+                &QAbstractItemModel::rowsInserted,
+                this,
+                [this, resort](const QModelIndex&, int first, int last)
+                {
+                    if (first != static_cast<int>(order.size())) {
+                        resort();
+                        return;
+                    }
+
+                    // appended rows, e.g. while a file is indexed, are shown at the end first
+                    beginInsertRows({}, first, last);
+                    for (int row = first; row <= last; ++row) {
+                        order.push_back(row);
+                        inverse.push_back(row);
+                    }
+                    endInsertRows();
+
+                    // a running sort merges them when it is applied
+                    if (keys && !sorting)
+                        apply(merged(std::vector<int>(order.begin(), order.begin() + keys->size())));
+                });
+        connect(model, &QAbstractItemModel::rowsRemoved, this, resort);
+        connect(model, &QAbstractItemModel::rowsMoved, this, resort);
+        connect(model, &QAbstractItemModel::layoutChanged, this, resort);
+        connect(model, &QAbstractItemModel::columnsInserted, this, resort);
+        connect(model, &QAbstractItemModel::columnsRemoved, this, resort);
+        connect(model,
+                &QAbstractItemModel::dataChanged,
+                this,
+                [this](const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles)
+                {
+                    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+                        const auto r = inverse[row];
+                        emit dataChanged(index(r, topLeft.column()), index(r, bottomRight.column()), roles);
+                    }
+                });
+        connect(model,
+                &QAbstractItemModel::headerDataChanged,
+                this,
+                [this](Qt::Orientation orientation, int first, int last)
+                {
+                    if (orientation == Qt::Horizontal)
+                        emit headerDataChanged(orientation, first, last);
+                    else
+                        emit headerDataChanged(orientation, 0, rowCount() - 1);
+                });
+    }
+
+    /// Role of the values compared, Qt::DisplayRole by default
+    void setSortRole(int role) { sortRole = role; }
+
+    void setSortCaseSensitivity(Qt::CaseSensitivity cs) { caseSensitivity = cs; }
+
+    /// Whether a sort is running on the worker pool
+    bool isSorting() const { return sorting; }
+
+    void sort(int column, Qt::SortOrder sortOrder = Qt::AscendingOrder) override
+    {
+        this->column    = column;
+        this->direction = sortOrder;
+
+        const auto model = sourceModel();
+        if (!model)
+            return;
+
+        if (column >= model->columnCount()) { // the current order is kept
+            ++*generation;
+            sorting = false;
+            keys.reset();
+            return;
+        }
+
+        if (column < 0) { // the order of the source model
+            ++*generation;
+            sorting = false;
+            keys.reset();
+            std::vector<int> result(inverse.size());
+            std::iota(result.begin(), result.end(), 0);
+            apply(std::move(result));
+            return;
+        }
+
+        // the keys are read on the GUI thread, the source model may not be used from other threads
+        keys            = std::make_shared<impl::proxies::Keys>(extract(column));
+        const auto rows = static_cast<int>(inverse.size());
+
+        if (rows < 10000) {
+            ++*generation;
+            sorting = false;
+            std::vector<int> result(rows);
+            std::iota(result.begin(), result.end(), 0);
+            keys->sort(result, sortOrder, false);
+            apply(std::move(result));
+            return;
+        }
+
+        const int generation = ++*this->generation;
+        sorting              = true;
+        QThreadPool::globalInstance()->start(
+            [this, counter = this->generation, generation, keys = keys, rows, sortOrder]
+            {
+                if (*counter != generation)
+                    return; // superseded before it started
+
+                std::vector<int> result(rows);
+                std::iota(result.begin(), result.end(), 0);
+                keys->sort(result, sortOrder, true);
+
+                QMetaObject::invokeMethod(
+                    QCoreApplication::instance(),
+                    [this, counter, generation, result = std::move(result)]() mutable
+                    {
+                        // the counter is -1 once the proxy is destroyed
+                        if (*counter != generation)
+                            return;
+                        sorting = false;
+                        apply(merged(std::move(result))); // with the rows appended meanwhile
+                    },
+                    Qt::QueuedConnection);
+            });
+    }
+
+    QModelIndex mapToSource(const QModelIndex& proxyIndex) const override
+    {
+        if (!proxyIndex.isValid() || !sourceModel())
+            return {};
+        return sourceModel()->index(order[proxyIndex.row()], proxyIndex.column());
+    }
+
+    QModelIndex mapFromSource(const QModelIndex& sourceIndex) const override
+    {
+        if (!sourceIndex.isValid())
+            return {};
+        return index(inverse[sourceIndex.row()], sourceIndex.column());
+    }
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = {}) const override
+    {
+        if (!hasIndex(row, column, parent))
+            return {};
+        return createIndex(row, column);
+    }
+
+    QModelIndex parent(const QModelIndex&) const override { return {}; }
+
+    int rowCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(order.size());
+    }
+
+    int columnCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() || !sourceModel() ? 0 : sourceModel()->columnCount();
+    }
+
+private:
+    std::vector<int>                     order;   // source row of each proxy row
+    std::vector<int>                     inverse; // proxy row of each source row
+    std::shared_ptr<impl::proxies::Keys> keys;    // of the first source rows, while sorted by column
+    int                                  column          = -1;
+    Qt::SortOrder                        direction       = Qt::AscendingOrder;
+    int                                  sortRole        = Qt::DisplayRole;
+    Qt::CaseSensitivity                  caseSensitivity = Qt::CaseSensitive;
+    bool                                 sorting         = false;
+    std::shared_ptr<std::atomic<int>>    generation      = std::make_shared<std::atomic<int>>(0);
+
+    void identity()
+    {
+        ++*generation; // a running sort no longer matches the rows
+        sorting = false;
+        keys.reset();
+
+        const auto rows = sourceModel() ? sourceModel()->rowCount() : 0;
+        order.resize(rows);
+        std::iota(order.begin(), order.end(), 0);
+        inverse = order;
+    }
+
+    impl::proxies::Keys extract(int column) const
+    {
+        const auto          model = sourceModel();
+        const auto          rows  = static_cast<int>(inverse.size());
+        impl::proxies::Keys keys;
+        keys.caseSensitivity = caseSensitivity;
+
+        for (int row = 0; row < rows && keys.type == QMetaType::UnknownType; ++row)
+            keys.type = model->data(model->index(row, column), sortRole).typeId();
+
+        switch (keys.type) {
+        case QMetaType::QString:
+        case QMetaType::QByteArray:
+        case QMetaType::QChar:
+        case QMetaType::UnknownType: keys.numeric = false; break;
+        default:
+            if (!QMetaType::canConvert(QMetaType(keys.type), QMetaType::fromType<double>())
+                && keys.type != QMetaType::QDate && keys.type != QMetaType::QDateTime
+                && keys.type != QMetaType::QTime)
+                keys.numeric = false;
+        }
+
+        read(keys, rows);
+        return keys;
+    }
+
+    /// Append the keys of the rows from keys.size() to rows
+    void read(impl::proxies::Keys& keys, int rows) const
+    {
+        const auto model = sourceModel();
+        const auto from  = keys.size();
+        if (keys.numeric)
+            keys.numbers.resize(rows);
+        else
+            keys.strings.resize(rows);
+
+        for (int row = from; row < rows; ++row) {
+            const auto value = model->data(model->index(row, column), sortRole);
+            if (!keys.numeric)
+                keys.strings[row] = value.toString();
+            else if (!value.isValid())
+                keys.numbers[row] = std::nan("");
+            else if (keys.type == QMetaType::QDate)
+                keys.numbers[row] = double(value.toDate().toJulianDay());
+            else if (keys.type == QMetaType::QDateTime)
+                keys.numbers[row] = double(value.toDateTime().toMSecsSinceEpoch());
+            else if (keys.type == QMetaType::QTime)
+                keys.numbers[row] = value.toTime().msecsSinceStartOfDay();
+            else
+                keys.numbers[row] = value.toDouble();
+        }
+    }
+
+    /// The sorted rows with keys, merged with the rows appended since, whose keys are read
+    std::vector<int> merged(std::vector<int> sorted)
+    {
+        const auto rows = static_cast<int>(inverse.size());
+        const auto from = keys->size();
+        Q_ASSERT(static_cast<int>(sorted.size()) == from);
+        if (from == rows)
+            return sorted;
+
+        read(*keys, rows);
+        std::vector<int> added(rows - from);
+        std::iota(added.begin(), added.end(), from);
+        keys->sort(added, direction, false);
+
+        std::vector<int> result;
+        result.reserve(rows);
+        std::merge(sorted.begin(),
+                   sorted.end(),
+                   added.begin(),
+                   added.end(),
+                   std::back_inserter(result),
+                   [this](int a, int b) { return keys->before(a, b, direction); });
+        return result;
+    }
+
+    /// Rows of source model in sorted order, applied with one layout change
+    void apply(std::vector<int> sorted)
+    {
+        Q_ASSERT(sorted.size() == order.size());
+
+        emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+        const auto persistent = persistentIndexList();
+        QModelIndexList sources;
+        sources.reserve(persistent.size());
+        for (const auto& index : persistent)
+            sources.append(mapToSource(index));
+
+        order = std::move(sorted);
+        for (int row = 0; row < static_cast<int>(order.size()); ++row)
+            inverse[order[row]] = row;
+
+        QModelIndexList mapped;
+        mapped.reserve(sources.size());
+        for (const auto& source : sources)
+            mapped.append(mapFromSource(source));
+        changePersistentIndexList(persistent, mapped);
+
+        emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+    }
+};
+
+/// Proxy showing the rows of a flat source model containing a text, see proxies.h
+class FilterProxyModel : public QAbstractProxyModel
+{
+public:
+    explicit FilterProxyModel(QObject* parent = nullptr)
+        : QAbstractProxyModel(parent)
+    {
+        setObjectName("nwidget::FilterProxyModel");
+    }
+
+    void setSourceModel(QAbstractItemModel* model) override
+    {
+        if (sourceModel())
+            disconnect(sourceModel(), nullptr, this, nullptr);
+
+        beginResetModel();
+        QAbstractProxyModel::setSourceModel(model);
+        indexed = false;
+        columns.clear();
+        filter();
+        endResetModel();
+
+        if (!model)
+            return;
+
+        const auto refilter = [this] { this->refilter(); };
+        connect(model, &QAbstractItemModel::modelReset, this, refilter);
+        connect(model, &QAbstractItemModel::rowsRemoved, this, refilter);
+        connect(model, &QAbstractItemModel::rowsMoved, this, refilter);
+        connect(model, &QAbstractItemModel::layoutChanged, this, refilter);
+        connect(model, &QAbstractItemModel::columnsInserted, this, refilter);
+        connect(model, &QAbstractItemModel::columnsRemoved, this, refilter);
+        connect(model,
+                &QAbstractItemModel::rowsInserted,
+                this,
+                [this](const QModelIndex&, int first, int last)
+                {
+                    if (first != static_cast<int>(inverse.size())) {
+                        this->refilter();
+                        return;
+                    }
+                    append(first, last);
+                });
+        connect(model,
+                &QAbstractItemModel::dataChanged,
+                this,
+                [this](const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles)
+                {
+                    if (indexed && (roles.isEmpty() || roles.contains(filterRole)))
+                        update(topLeft.row(), bottomRight.row(), topLeft.column(), bottomRight.column());
+                    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+                        if (const auto r = inverse[row]; r >= 0)
+                            emit dataChanged(index(r, topLeft.column()), index(r, bottomRight.column()), roles);
+                    }
+                });
+        connect(model,
+                &QAbstractItemModel::headerDataChanged,
+                this,
+                [this](Qt::Orientation orientation, int first, int last)
+                {
+                    if (orientation == Qt::Horizontal)
+                        emit headerDataChanged(orientation, first, last);
+                    else if (rowCount() > 0)
+                        emit headerDataChanged(orientation, 0, rowCount() - 1);
+                });
+    }
+
+    /// Columns searched for the filter text, all columns if empty
+    void setFilterColumns(const QList<int>& columns)
+    {
+        filterColumns = columns;
+        refilter();
+    }
+
+    /// Role of the values searched, Qt::DisplayRole by default
+    void setFilterRole(int role)
+    {
+        filterRole = role;
+        refilter();
+    }
+
+    QString filterText() const { return text; }
+
+    /// Show the rows containing text, case-insensitive
+    void setFilterText(const QString& text)
+    {
+        const auto folded = text.toCaseFolded().toUtf8();
+        if (folded == query)
+            return;
+
+        // an extended text matches a subset of the rows matching the previous one
+        const auto narrow = indexed && !query.isEmpty() && folded.contains(query);
+        this->text        = text;
+        query             = folded;
+
+        beginResetModel();
+        if (narrow) {
+            std::vector<int> matches;
+            for (const auto row : rows)
+                if (accepts(row))
+                    matches.push_back(row);
+            rows = std::move(matches);
+            map();
+        } else
+            filter();
+        endResetModel();
+    }
+
+    QModelIndex mapToSource(const QModelIndex& proxyIndex) const override
+    {
+        if (!proxyIndex.isValid() || !sourceModel())
+            return {};
+        return sourceModel()->index(rows[proxyIndex.row()], proxyIndex.column());
+    }
+
+    QModelIndex mapFromSource(const QModelIndex& sourceIndex) const override
+    {
+        if (!sourceIndex.isValid())
+            return {};
+        const auto row = inverse[sourceIndex.row()];
+        return row < 0 ? QModelIndex() : index(row, sourceIndex.column());
+    }
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = {}) const override
+    {
+        if (!hasIndex(row, column, parent))
+            return {};
+        return createIndex(row, column);
+    }
+
+    QModelIndex parent(const QModelIndex&) const override { return {}; }
+
+    int rowCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(rows.size());
+    }
+
+    int columnCount(const QModelIndex& parent = {}) const override
+    {
+        return parent.isValid() || !sourceModel() ? 0 : sourceModel()->columnCount();
+    }
+
+private:
+    QString                                 text;
+    QByteArray                              query; // case-folded UTF-8 of text
+    QList<int>                              filterColumns;
+    int                                     filterRole = Qt::DisplayRole;
+    std::vector<impl::proxies::TextColumn>  columns;
+    bool                                    indexed = false;
+    std::vector<int>                        rows;    // source row of each proxy row
+    std::vector<int>                        inverse; // proxy row of each source row, -1 if it is filtered out
+
+    int sourceRows() const { return sourceModel() ? sourceModel()->rowCount() : 0; }
+
+    bool accepts(int row) const
+    {
+        return query.isEmpty()
+            || std::any_of(columns.begin(), columns.end(), [&](const auto& c) { return c.contains(row, query); });
+    }
+
+    /// Drop the text index and filter all rows again
+    void refilter()
+    {
+        beginResetModel();
+        indexed = false;
+        columns.clear();
+        filter();
+        endResetModel();
+    }
+
+    void buildIndex()
+    {
+        if (indexed)
+            return;
+        indexed = true;
+
+        auto list = filterColumns;
+        if (list.isEmpty() && sourceModel())
+            for (int column = 0; column < sourceModel()->columnCount(); ++column)
+                list.append(column);
+
+        const auto model = sourceModel();
+        const auto count = sourceRows();
+        for (const auto column : list) {
+            impl::proxies::TextColumn c{column, {}, {0}};
+            c.starts.reserve(count + 1);
+            for (int row = 0; row < count; ++row)
+                c.append(model->data(model->index(row, column), filterRole).toString());
+            columns.push_back(std::move(c));
+        }
+    }
+
+    void filter()
+    {
+        const auto count = sourceRows();
+        rows.clear();
+        if (query.isEmpty()) {
+            rows.resize(count);
+            std::iota(rows.begin(), rows.end(), 0);
+        } else {
+            buildIndex();
+            std::vector<char> hits(count);
+            for (const auto& column : columns)
+                column.scan(query, hits);
+            for (int row = 0; row < count; ++row)
+                if (hits[row])
+                    rows.push_back(row);
+        }
+        map();
+    }
+
+    void map()
+    {
+        inverse.assign(sourceRows(), -1);
+        for (int row = 0; row < static_cast<int>(rows.size()); ++row)
+            inverse[rows[row]] = row;
+    }
+
+    /// Update the index of the changed cells of the filter columns, and show or hide the changed rows
+    void update(int first, int last, int left, int right)
+    {
+        const auto model    = sourceModel();
+        bool       affected = false;
+        for (auto& column : columns) {
+            if (column.column < left || column.column > right)
+                continue;
+            affected = true;
+            for (int row = first; row <= last; ++row)
+                column.set(row, model->data(model->index(row, column.column), filterRole).toString());
+        }
+        if (!affected || query.isEmpty())
+            return;
+
+        // each shown or hidden row shifts the rows after it, many rows are filtered again at once
+        if (last - first >= 1024) {
+            beginResetModel();
+            filter();
+            endResetModel();
+            return;
+        }
+
+        for (int row = first; row <= last; ++row) {
+            const auto shown = inverse[row] >= 0;
+            if (accepts(row) == shown)
+                continue;
+
+            if (shown) {
+                const auto r = inverse[row];
+                beginRemoveRows({}, r, r);
+                rows.erase(rows.begin() + r);
+                inverse[row] = -1;
+                renumber(r);
+                endRemoveRows();
+            } else {
+                const auto r = static_cast<int>(std::lower_bound(rows.begin(), rows.end(), row) - rows.begin());
+                beginInsertRows({}, r, r);
+                rows.insert(rows.begin() + r, row);
+                renumber(r);
+                endInsertRows();
+            }
+        }
+    }
+
+    /// Update the proxy rows of the rows from proxy row first on
+    void renumber(int first)
+    {
+        for (int row = first; row < static_cast<int>(rows.size()); ++row)
+            inverse[rows[row]] = row;
+    }
+
+    /// Index and filter the rows appended to the source model, e.g. while a file is indexed
+    void append(int first, int last)
+    {
+        const auto model = sourceModel();
+        if (indexed)
+            for (auto& column : columns)
+                for (int row = first; row <= last; ++row)
+                    column.append(model->data(model->index(row, column.column), filterRole).toString());
+
+        std::vector<int> matches;
+        for (int row = first; row <= last; ++row)
+            if (accepts(row))
+                matches.push_back(row);
+
+        inverse.resize(last + 1, -1);
+        if (matches.empty())
+            return;
+
+        const auto begin = static_cast<int>(rows.size());
+        beginInsertRows({}, begin, begin + static_cast<int>(matches.size()) - 1);
+        for (const auto row : matches) {
+            inverse[row] = static_cast<int>(rows.size());
+            rows.push_back(row);
+        }
+        endInsertRows();
+    }
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_PROXIES_H
@@ -0,0 +1,379 @@
+/**
+ * @brief Re-run declarative descriptions and reconcile them with the live widgets
+ * @details
+ * A description is a function returning a layout. The reconciler installs its result on the host widget, and
+ * every update runs the description again, compares the new result with the previous one and applies only what
+ * differs to the live widgets:
+ *      @code{.cpp}
+ *      auto reconciler = Reconciler::on(window, [&] {
+ *          return VBoxLayout{
+ *              Label(QString::number(counter)),
+ *              PushButton(counter > 10 ? "Reset" : "Increment"),
+ *          };
+ *      });
+ *
+ *      ++counter;
+ *      reconciler->update(); // only the label text and the button text are written
+ *      @endcode
+ *
+ * The description can also be re-run whenever observed properties change, updates are coalesced:
+ *      @code{.cpp}
+ *      Reconciler::on(window, description, slider.value(), checkBox.checked());
+ *      @endcode
+ *
+ * Reconciliation rules:
+ *      - Objects are matched by position, class and objectName.
+ *      - Writable, stored Qt properties which differ between the two descriptions are written to the live object.
+ *      - Item alignment, box stretch and spacer sizes are updated in place.
+ *      - A widget whose class or objectName changed is replaced by the new one.
+ *      - A layout whose items changed in number, kind or grid/form position is replaced with its widgets.
+ *      - Everything of the new description that was not taken over is deleted, including its bindings and
+ *        connections. The live widgets keep the bindings and connections of the description that created them.
+ */
+
+#ifndef NWIDGET_RECONCILE_H
+#define NWIDGET_RECONCILE_H
+
+#include "metaobject.h"
+
+#include <QBoxLayout>
+#include <QFormLayout>
+#include <QGridLayout>
+#include <QMetaProperty>
+#include <QTimer>
+#include <QWidget>
+
+#include <functional>
+#include <vector>
+
+namespace nwidget {
+
+namespace impl::reconcile {
+
+struct Node
+{
+    enum Kind { Other, Spacer, Widget, Layout };
+
+    Kind                  kind = Other;
+    const QMetaObject*    meta = nullptr;
+    QString               name;
+    std::vector<QVariant> values;   // writable and stored properties, invalid for the others
+    std::vector<Node>     children; // widget: its layout, layout: its items
+    std::vector<int>      position; // grid: row, column, spans; form: row, role
+    int                   stretch = 0;
+    Qt::Alignment         align;
+    QSize                 spacerSize;
+    QSizePolicy           spacerPolicy;
+};
+
+inline void properties(QObject* o, Node& node)
+{
+    node.meta = o->metaObject();
+    node.name = o->objectName();
+    node.values.resize(node.meta->propertyCount());
+    for (int i = 0; i < node.meta->propertyCount(); ++i) {
+        const auto p = node.meta->property(i);
+        if (p.isWritable() && p.isStored())
+            node.values[i] = p.read(o);
+    }
+}
+
+inline Node snapshot(QLayout* layout);
+
+inline Node snapshot(QWidget* widget)
+{
+    Node node;
+    node.kind = Node::Widget;
+    properties(widget, node);
+    if (widget->layout())
+        node.children.push_back(snapshot(widget->layout()));
+    return node;
+}
+
+inline Node snapshot(QLayout* layout)
+{
+    Node node;
+    node.kind = Node::Layout;
+    properties(layout, node);
+
+    for (int i = 0; i < layout->count(); ++i) {
+        const auto item = layout->itemAt(i);
+
+        Node child;
+        if (item->widget())
+            child = snapshot(item->widget());
+        else if (item->layout())
+            child = snapshot(item->layout());
+        else if (const auto spacer = item->spacerItem()) {
+            child.kind         = Node::Spacer;
+            child.spacerSize   = spacer->sizeHint();
+            child.spacerPolicy = spacer->sizePolicy();
+        }
+
+        child.align = item->alignment();
+        if (const auto box = qobject_cast<QBoxLayout*>(layout))
+            child.stretch = box->stretch(i);
+        else if (const auto grid = qobject_cast<QGridLayout*>(layout)) {
+            int r, c, rs, cs;
+            grid->getItemPosition(i, &r, &c, &rs, &cs);
+            child.position = {r, c, rs, cs};
+        } else if (const auto form = qobject_cast<QFormLayout*>(layout)) {
+            int                   r;
+            QFormLayout::ItemRole role;
+            form->getItemPosition(i, &r, &role);
+            child.position = {r, role};
+        }
+
+        node.children.push_back(std::move(child));
+    }
+
+    return node;
+}
+
+inline bool sameShape(const Node& a, const Node& b)
+{
+    if (a.meta != b.meta || a.children.size() != b.children.size())
+        return false;
+    for (std::size_t i = 0; i < a.children.size(); ++i) {
+        const auto& x = a.children[i];
+        const auto& y = b.children[i];
+        if (x.kind != y.kind || x.position != y.position)
+            return false;
+        if (x.kind == Node::Layout && !sameShape(x, y))
+            return false;
+    }
+    return true;
+}
+
+/// Whether the items of live and its nested layouts still correspond to the snapshot prev
+inline bool matches(QLayout* live, const Node& prev)
+{
+    if (live->count() != static_cast<int>(prev.children.size()))
+        return false;
+    for (int i = 0; i < live->count(); ++i) {
+        const auto item = live->itemAt(i);
+        switch (prev.children[i].kind) {
+        case Node::Widget:
+            if (!item->widget())
+                return false;
+            break;
+        case Node::Layout:
+            if (!item->layout() || !matches(item->layout(), prev.children[i]))
+                return false;
+            break;
+        case Node::Spacer:
+            if (!item->spacerItem())
+                return false;
+            break;
+        case Node::Other:
+            break;
+        }
+    }
+    return true;
+}
+
+inline void apply(QObject* live, const Node& prev, const Node& next)
+{
+    for (std::size_t i = 0; i < next.values.size(); ++i)
+        if (next.values[i].isValid() && !(prev.values[i] == next.values[i]))
+            next.meta->property(static_cast<int>(i)).write(live, next.values[i]);
+}
+
+/// Delete a layout of the new description with everything it manages
+inline void destroy(QLayout* layout)
+{
+    while (const auto item = layout->takeAt(0)) {
+        if (const auto l = item->layout())
+            destroy(l);
+        else {
+            delete item->widget();
+            delete item;
+        }
+    }
+    delete layout;
+}
+
+/// Remove a live layout with everything it manages, widgets are deleted later as they may be sending a signal
+inline void retire(QLayout* layout)
+{
+    while (const auto item = layout->takeAt(0)) {
+        if (const auto l = item->layout())
+            retire(l);
+        else {
+            if (const auto w = item->widget()) {
+                w->hide();
+                w->deleteLater();
+            }
+            delete item;
+        }
+    }
+    delete layout;
+}
+
+inline void replaceLayout(QWidget* owner, QLayout* fresh)
+{
+    if (owner->layout())
+        retire(owner->layout());
+    if (fresh)
+        owner->setLayout(fresh);
+}
+
+inline void reconcileLayout(QLayout* live, const Node& prev, QLayout* fresh, const Node& next);
+
+inline void reconcileWidget(QLayout*    liveParent,
+                            QWidget*    live,
+                            const Node& prev,
+                            QLayout*    freshParent,
+                            QWidget*    fresh,
+                            const Node& next)
+{
+    if (prev.meta != next.meta || prev.name != next.name) {
+        freshParent->removeWidget(fresh);
+        delete liveParent->replaceWidget(live, fresh);
+        live->hide();
+        live->deleteLater();
+        return;
+    }
+
+    apply(live, prev, next);
+
+    const auto prevLayout = prev.children.empty() ? nullptr : &prev.children.front();
+    const auto nextLayout = next.children.empty() ? nullptr : &next.children.front();
+    if (!prevLayout && !nextLayout)
+        return;
+
+    if (prevLayout && nextLayout && live->layout() && sameShape(*prevLayout, *nextLayout)
+        && matches(live->layout(), *prevLayout))
+        reconcileLayout(live->layout(), *prevLayout, fresh->layout(), *nextLayout);
+    else
+        replaceLayout(live, fresh->layout());
+}
+
+inline void reconcileLayout(QLayout* live, const Node& prev, QLayout* fresh, const Node& next)
+{
+    apply(live, prev, next);
+
+    // Taking over widgets changes the new layout, keep its items as they are now
+    std::vector<QLayoutItem*> freshItems;
+    for (int i = 0; i < fresh->count(); ++i)
+        freshItems.push_back(fresh->itemAt(i));
+
+    for (int i = 0; i < live->count(); ++i) {
+        const auto  liveItem  = live->itemAt(i);
+        const auto  freshItem = freshItems[i];
+        const auto& p         = prev.children[i];
+        const auto& n         = next.children[i];
+
+        if (p.align != n.align) {
+            liveItem->setAlignment(n.align);
+            live->invalidate();
+        }
+        if (p.stretch != n.stretch)
+            if (const auto box = qobject_cast<QBoxLayout*>(live))
+                box->setStretch(i, n.stretch);
+
+        switch (n.kind) {
+        case Node::Widget:
+            reconcileWidget(live, liveItem->widget(), p, fresh, freshItem->widget(), n);
+            break;
+        case Node::Layout:
+            reconcileLayout(liveItem->layout(), p, freshItem->layout(), n);
+            break;
+        case Node::Spacer:
+            if (p.spacerSize != n.spacerSize || p.spacerPolicy != n.spacerPolicy) {
+                liveItem->spacerItem()->changeSize(n.spacerSize.width(),
+                                                   n.spacerSize.height(),
+                                                   n.spacerPolicy.horizontalPolicy(),
+                                                   n.spacerPolicy.verticalPolicy());
+                live->invalidate();
+            }
+            break;
+        case Node::Other:
+            break;
+        }
+    }
+}
+
+} // namespace impl::reconcile
+
+class Reconciler : public QObject
+{
+    Q_DISABLE_COPY_MOVE(Reconciler)
+
+public:
+    template <typename Description, typename... Deps>
+    static Reconciler* on(QWidget* host, Description description, Deps... deps)
+    {
+        Q_ASSERT(host);
+
+        auto r =
+            static_cast<Reconciler*>(host->findChild<QObject*>("nwidget::Reconciler", Qt::FindDirectChildrenOnly));
+        if (!r)
+            r = new Reconciler(host);
+
+        for (const auto& connection : r->connections)
+            QObject::disconnect(connection);
+        r->connections.clear();
+        r->describe = [description]() -> QLayout* { return description(); };
+        (r->observe(deps), ...);
+
+        QLayout* fresh = r->describe();
+        r->snapshot    = impl::reconcile::snapshot(fresh);
+        impl::reconcile::replaceLayout(host, fresh);
+
+        return r;
+    }
+
+    /// Re-run the description and apply the differences to the live widgets
+    void update()
+    {
+        pending = false;
+
+        const auto host  = static_cast<QWidget*>(parent());
+        QLayout*   fresh = describe();
+        auto       next  = impl::reconcile::snapshot(fresh);
+
+        const auto live = host->layout();
+        // layouts changed outside of the description, e.g. items removed by hand, are rebuilt
+        if (live && impl::reconcile::sameShape(snapshot, next) && impl::reconcile::matches(live, snapshot)) {
+            impl::reconcile::reconcileLayout(live, snapshot, fresh, next);
+            impl::reconcile::destroy(fresh);
+        } else
+            impl::reconcile::replaceLayout(host, fresh);
+
+        snapshot = std::move(next);
+    }
+
+    /// Update once the event loop is reached, multiple requests result in a single update
+    void scheduleUpdate()
+    {
+        if (pending)
+            return;
+        pending = true;
+        QTimer::singleShot(0, this, [this] { update(); });
+    }
+
+private:
+    std::function<QLayout*()>            describe;
+    impl::reconcile::Node                snapshot;
+    std::vector<QMetaObject::Connection> connections; // to the dependencies of describe
+    bool                                 pending = false;
+
+    explicit Reconciler(QWidget* host)
+        : QObject(host)
+    {
+        setObjectName("nwidget::Reconciler");
+    }
+
+    template <typename... Ts> void observe(MetaProperty<Ts...> prop)
+    {
+        using MetaProp = MetaProperty<Ts...>;
+        static_assert(MetaProp::hasNotifySignal);
+        connections.push_back(
+            QObject::connect(prop.object(), MetaProp::notify(), this, [this] { scheduleUpdate(); }));
+    }
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_RECONCILE_H
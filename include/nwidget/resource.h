@@ -0,0 +1,285 @@
+/**
+ * @brief Load images and fonts on a worker pool instead of the GUI thread
+ * @details
+ * Preload the resources before building, decoding starts at once on QThreadPool::globalInstance():
+ *      @code{.cpp}
+ *      Resources::preload({":/icons/open.png", ":/icons/save.png"});
+ *      @endcode
+ *
+ * Builder properties accept a pending resource. The placeholder is written first and the loaded value is swapped
+ * in from the GUI thread once it is ready:
+ *      @code{.cpp}
+ *      QLayout* layout = VBoxLayout{
+ *          PushButton("Open").icon(Resources::icon(":/icons/open.png")),
+ *          Label().pixmap(Resources::pixmap("background.jpg", placeholder)),
+ *          Label("Title").font(Resources::font("fonts/title.ttf")),
+ *      };
+ *      @endcode
+ *
+ * Pending resources can also be used outside of builders:
+ *      @code{.cpp}
+ *      Resources::image("large.png").then(widget, [widget](const QImage& image) { ... });
+ *      @endcode
+ *
+ * Notes:
+ *      - Resources are cached per path for the whole process, use Resources::clear() to release them.
+ *      - Only decoding and file reading happen on the worker pool. QPixmap, QIcon and application fonts are
+ *        created on the GUI thread when the resource is used.
+ *      - A resource which fails to load keeps the placeholder.
+ *      - Images can be decoded at a reduced size with Resources::image(path, ImageSize(size, ratio)) and
+ *        Resources::pixmap(path, ImageSize(size, ratio)). Larger images are scaled down to size times the device
+ *        pixel ratio and tagged with that ratio, smaller images are not scaled up. Label().imageAsync(path, size)
+ *        shows such a pixmap at the device pixel ratio of the label.
+ */
+
+#ifndef NWIDGET_RESOURCE_H
+#define NWIDGET_RESOURCE_H
+
+#include "metaobject.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFont>
+#include <QFontDatabase>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <QImageReader>
+#include <QPixmap>
+#include <QPointer>
+#include <QThread>
+#include <QThreadPool>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace nwidget {
+
+/// Size to decode an image at, in device independent pixels of a screen with the device pixel ratio
+struct ImageSize
+{
+    explicit ImageSize(const QSize& size, qreal devicePixelRatio = 1)
+        : size(size)
+        , devicePixelRatio(devicePixelRatio)
+    {
+    }
+
+    QSize size;
+    qreal devicePixelRatio;
+};
+
+namespace impl::resource {
+
+struct Entry : std::enable_shared_from_this<Entry>
+{
+    enum Kind { Image, Font };
+
+    Kind    kind;
+    QString path;
+    QSize   size;      // decode images scaled down to fit, in device pixels, if valid
+    qreal   ratio = 1; // device pixel ratio of images decoded at size
+
+    // written by the worker, read by the GUI thread after finish() is posted
+    QImage     image;
+    QByteArray data;
+
+    // GUI thread only
+    bool    finished = false;
+    QPixmap pixmap;
+    QIcon   icon;
+    QFont   font;
+    bool    hasFont = false;
+
+    std::vector<std::pair<QPointer<QObject>, std::function<void()>>> waiters;
+
+    Entry(Kind kind, const QString& path, const QSize& size, qreal ratio)
+        : kind(kind)
+        , path(path)
+        , size(size)
+        , ratio(ratio)
+    {
+    }
+
+    void load()
+    {
+        if (kind == Image) {
+            QImageReader reader(path);
+            reader.setAutoTransform(true);
+            if (size.isValid()) {
+                // formats which cannot decode at a reduced size are scaled by the reader after decoding
+                auto scaled = reader.size();
+                if (scaled.isValid() && (scaled.width() > size.width() || scaled.height() > size.height())) {
+                    scaled.scale(size, Qt::KeepAspectRatio);
+                    reader.setScaledSize(scaled);
+                }
+            }
+            image = reader.read();
+            if (size.isValid())
+                image.setDevicePixelRatio(ratio); // carried over to the pixmap and icon
+        } else {
+            QFile file(path);
+            if (file.open(QIODevice::ReadOnly))
+                data = file.readAll();
+        }
+
+        QMetaObject::invokeMethod(
+            QCoreApplication::instance(), [self = shared_from_this()] { self->finish(); }, Qt::QueuedConnection);
+    }
+
+    void finish()
+    {
+        finished = true;
+
+        if (kind == Font) {
+            const auto families = QFontDatabase::applicationFontFamilies(QFontDatabase::addApplicationFontFromData(data));
+            if (!families.isEmpty()) {
+                font    = QFont(families.first());
+                hasFont = true;
+            }
+            data.clear();
+        }
+
+        const auto ws = std::move(waiters);
+        for (const auto& [context, func] : ws)
+            if (context)
+                func();
+    }
+
+    bool valid() const { return kind == Image ? !image.isNull() : hasFont; }
+};
+
+inline QHash<QString, std::shared_ptr<Entry>>& cache()
+{
+    static QHash<QString, std::shared_ptr<Entry>> entries;
+    return entries;
+}
+
+inline std::shared_ptr<Entry> entry(Entry::Kind kind, const QString& path, const QSize& size = {}, qreal ratio = 1)
+{
+    Q_ASSERT(QThread::currentThread() == QCoreApplication::instance()->thread());
+
+    auto key = QString::number(kind) + QLatin1Char(':');
+    if (size.isValid())
+        key += QStringLiteral("%1x%2@%3:").arg(size.width()).arg(size.height()).arg(ratio);
+    key += path;
+
+    auto& e = cache()[key];
+    if (!e) {
+        e = std::make_shared<Entry>(kind, path, size, ratio);
+        QThreadPool::globalInstance()->start([e] { e->load(); });
+    }
+    return e;
+}
+
+template <typename T> T convert(Entry& e)
+{
+    if constexpr (std::is_same_v<T, QImage>)
+        return e.image;
+    else if constexpr (std::is_same_v<T, QPixmap>) {
+        if (e.pixmap.isNull())
+            e.pixmap = QPixmap::fromImage(e.image);
+        return e.pixmap;
+    } else if constexpr (std::is_same_v<T, QIcon>) {
+        if (e.icon.isNull())
+            e.icon = QIcon(convert<QPixmap>(e));
+        return e.icon;
+    } else if constexpr (std::is_same_v<T, QFont>)
+        return e.font;
+}
+
+} // namespace impl::resource
+
+/// A resource being loaded, converts to its placeholder until the resource is ready
+template <typename T> class Pending
+{
+public:
+    using Type = T;
+
+    Pending(std::shared_ptr<impl::resource::Entry> entry, const T& placeholder = {})
+        : entry(std::move(entry))
+        , placeholder(placeholder)
+    {
+    }
+
+    bool isReady() const { return entry->finished; }
+
+    T value() const { return isReady() && entry->valid() ? impl::resource::convert<T>(*entry) : placeholder; }
+
+    operator T() const { return value(); }
+
+    /// Call func with the value when the resource is ready, unless context has been destroyed
+    template <typename Func> void then(QObject* context, Func func) const
+    {
+        Q_ASSERT(context);
+
+        if (isReady()) {
+            func(value());
+            return;
+        }
+
+        entry->waiters.emplace_back(context, [self = *this, func]() { func(self.value()); });
+    }
+
+private:
+    std::shared_ptr<impl::resource::Entry> entry;
+    T                                      placeholder;
+};
+
+class Resources
+{
+public:
+    /// Start loading images ahead of building
+    static void preload(const QStringList& paths)
+    {
+        for (const auto& path : paths)
+            impl::resource::entry(impl::resource::Entry::Image, path);
+    }
+
+    static Pending<QImage> image(const QString& path, const QImage& placeholder = {})
+    {
+        return {impl::resource::entry(impl::resource::Entry::Image, path), placeholder};
+    }
+
+    static Pending<QPixmap> pixmap(const QString& path, const QPixmap& placeholder = {})
+    {
+        return {impl::resource::entry(impl::resource::Entry::Image, path), placeholder};
+    }
+
+    /// Decode the image scaled down to fit into size, keeping its aspect ratio, cached per path and size
+    static Pending<QImage> image(const QString& path, const ImageSize& size, const QImage& placeholder = {})
+    {
+        return {entry(path, size), placeholder};
+    }
+
+    /// Decode the image scaled down to fit into size, keeping its aspect ratio, cached per path and size
+    static Pending<QPixmap> pixmap(const QString& path, const ImageSize& size, const QPixmap& placeholder = {})
+    {
+        return {entry(path, size), placeholder};
+    }
+
+    static Pending<QIcon> icon(const QString& path, const QIcon& placeholder = {})
+    {
+        return {impl::resource::entry(impl::resource::Entry::Image, path), placeholder};
+    }
+
+    /// Register an application font, the value is a QFont of its first family
+    static Pending<QFont> font(const QString& path, const QFont& placeholder = {})
+    {
+        return {impl::resource::entry(impl::resource::Entry::Font, path), placeholder};
+    }
+
+    /// Release the cached resources, pending loads still complete for their users
+    static void clear() { impl::resource::cache().clear(); }
+
+private:
+    static std::shared_ptr<impl::resource::Entry> entry(const QString& path, const ImageSize& size)
+    {
+        const auto pixels = size.size * size.devicePixelRatio;
+        return impl::resource::entry(impl::resource::Entry::Image, path, pixels, size.devicePixelRatio);
+    }
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_RESOURCE_H
@@ -0,0 +1,162 @@
+/**
+ * @brief Share identical style sheets between widgets
+ * @details
+ * Each QWidget::setStyleSheet parses the sheet and polishes the widget again, even for identical strings.
+ * A shared style sheet is only tagged on the widget while building:
+ *      @code{.cpp}
+ *      QLayout* layout = VBoxLayout{
+ *          ForEach(0, 1000, [](int i) { return PushButton(QString::number(i)).sharedStyleSheet("color: red"); }),
+ *      };
+ *      @endcode
+ *
+ * Identical sheets get the same id. When the first tagged widget of a window is polished, the sheets of all tagged
+ * widgets of the window are lifted into the window style sheet once, per id and depth below the window:
+ *      @code{.css}
+ *      *[nwidget_style="0"][nwidget_depth="2"] * { color: red }
+ *      ...
+ *      *[nwidget_style="0"][nwidget_depth="2"] { color: red }
+ *      @endcode
+ *
+ *      The rules for descendants are ordered by depth and followed by the rules for the widgets themselves, so that
+ *      like with QWidget::setStyleSheet the sheet of a widget takes precedence over the sheets of its ancestors.
+ *
+ * Notes:
+ *      - Only sheets without selectors are lifted, other sheets are set on the widget directly.
+ *      - Widgets tagged after being polished, or polished after their window has lifted its sheets without them,
+ *        get the sheet set directly.
+ *      - Lifted rules are part of the window style sheet, a style sheet set on a widget itself or one of its
+ *        ancestors below the window takes precedence over them.
+ *      - Moving a tagged widget to another window after it has been polished does not move its sheet.
+ */
+
+#ifndef NWIDGET_STYLESHEET_H
+#define NWIDGET_STYLESHEET_H
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+#include <QVariant>
+#include <QWidget>
+
+namespace nwidget {
+
+class StyleSheets : public QObject
+{
+    Q_DISABLE_COPY_MOVE(StyleSheets)
+
+public:
+    /// Apply sheet to widget, identical sheets are parsed once per window
+    static void share(QWidget* widget, const QString& sheet)
+    {
+        Q_ASSERT(widget);
+
+        if (sheet.contains(QLatin1Char('{')) || widget->testAttribute(Qt::WA_WState_Polished)) {
+            widget->setStyleSheet(sheet);
+            return;
+        }
+
+        const auto s  = instance();
+        auto       it = s->ids.constFind(sheet);
+        if (it == s->ids.cend()) {
+            it = s->ids.insert(sheet, s->sheets.size());
+            s->sheets.append(sheet);
+        }
+
+        widget->setProperty(idProperty, *it);
+        widget->installEventFilter(s);
+    }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (event->type() != QEvent::Polish)
+            return false;
+
+        const auto widget = static_cast<QWidget*>(watched);
+        widget->removeEventFilter(this);
+
+        const auto id = widget->property(idProperty);
+        if (!id.isValid())
+            return false;
+
+        const auto window = widget->window();
+        if (!window->property(liftedProperty).isValid())
+            lift(window);
+        if (!widget->property(depthProperty).isValid())
+            widget->setStyleSheet(sheets.at(id.toInt()));
+
+        return false;
+    }
+
+private:
+    static constexpr const char* idProperty     = "nwidget_style";
+    static constexpr const char* liftedProperty = "nwidget_styles";
+    static constexpr const char* depthProperty  = "nwidget_depth";
+
+    QHash<QString, int> ids;
+    QStringList         sheets;
+
+    explicit StyleSheets(QObject* parent)
+        : QObject(parent)
+    {
+        setObjectName("nwidget::StyleSheets");
+    }
+
+    static StyleSheets* instance()
+    {
+        const auto app = QCoreApplication::instance();
+        Q_ASSERT(app);
+
+        auto s = static_cast<StyleSheets*>(app->findChild<QObject*>("nwidget::StyleSheets", Qt::FindDirectChildrenOnly));
+        if (!s)
+            s = new StyleSheets(app);
+        return s;
+    }
+
+    void lift(QWidget* window)
+    {
+        // one rule per id and depth, rules of equal specificity declared later win
+        QMap<int, QSet<int>> levels; // ids by depth
+
+        const auto add = [&](QWidget* w)
+        {
+            const auto id = w->property(idProperty);
+            if (!id.isValid())
+                return;
+
+            int depth = 0;
+            for (auto p = w; p != window; p = p->parentWidget())
+                ++depth;
+            w->setProperty(depthProperty, depth);
+            levels[depth].insert(id.toInt());
+        };
+
+        add(window);
+        for (const auto w : window->findChildren<QWidget*>())
+            add(w);
+
+        QString descendants, own;
+        for (auto it = levels.cbegin(); it != levels.cend(); ++it) {
+            for (const auto id : it.value()) {
+                const auto selector = QStringLiteral("*[%1=\"%2\"][%3=\"%4\"]")
+                                          .arg(QLatin1String(idProperty))
+                                          .arg(id)
+                                          .arg(QLatin1String(depthProperty))
+                                          .arg(it.key());
+                descendants += QStringLiteral("\n%1 * { %2 }").arg(selector, sheets.at(id));
+                own += QStringLiteral("\n%1 { %2 }").arg(selector, sheets.at(id));
+            }
+        }
+
+        window->setProperty(liftedProperty, true);
+        if (!levels.isEmpty())
+            window->setStyleSheet(window->styleSheet() + descendants + own);
+    }
+};
+
+} // namespace nwidget
+
+#endif // NWIDGET_STYLESHEET_H
@@ -0,0 +1,7 @@
+#define N_PREBUILT_INSTANTIATE
+#include <nwidget/prebuilt.h>
+
+#define N_IMPL_PREBUILT_INSTANTIATE_X(CLASS, BASE) template class nwidget::Builder<BASE, nwidget::Builder<CLASS>>;
+#define N_IMPL_PREBUILT_INSTANTIATE_Y(CLASS)       template class nwidget::Builder<CLASS>;
+
+N_PREBUILT_BUILDERS(N_IMPL_PREBUILT_INSTANTIATE_X, N_IMPL_PREBUILT_INSTANTIATE_Y)